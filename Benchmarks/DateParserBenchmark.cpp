@@ -0,0 +1,94 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../SortingFlights/DateParser.h"
+
+/*
+	Microbenchmark which compares DateParser::parse with old std::stringstream way of reading
+	flight time field (which Flight::readDate used before DateParser).
+
+	It is not part of SortingFlights project, it is built from command line together with sources
+	it needs, e.g.:
+
+		cl /O2 /EHsc DateParserBenchmark.cpp ..\SortingFlights\DateParser.cpp ..\SortingFlights\Flight.cpp ..\SortingFlights\StreamReader.cpp ..\SortingFlights\DelimiterScanner.cpp
+
+	Optional command line argument is number of dates (default 1000000), result is time needed
+	for one million dates with both ways.
+
+	@author Acko.
+*/
+
+/*
+	Old way, five numbers are read from stream, and checked same as in DateParser.
+
+	@param date		-> (const char *) null terminated field.
+	@param timeKey	-> (int&) sum of numbers (enough so that compiler can't drop the work).
+
+	@return (bool) true if field is valid.
+*/
+bool parseWithStream(const char* date, int& timeKey)
+{
+	std::stringstream ss;
+	ss << date;
+
+	char temp;
+	int day, month, year, hour, minute;
+	ss >> day >> temp >> month >> temp >> year >> temp >> hour >> temp >> minute;
+
+	if (ss.fail() || day > 31 || month > 12 || year > 2100 || hour > 23 || minute > 60)
+		return false;
+
+	timeKey = day + month + year + hour + minute;
+	return true;
+}
+
+/*
+	Function which runs one way of parsing over all dates and prints time per million dates.
+
+	@param name		-> (const char *) name printed in result.
+	@param dates	-> (const std::vector<std::string>&) dates which are parsed.
+	@param parse	-> (bool(*)(const char *, int&)) parsing function.
+*/
+void measure(const char* name, const std::vector<std::string>& dates, bool(*parse)(const char *, int&))
+{
+	long long checksum = 0;
+	int timeKey = 0;
+
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+	for (size_t i = 0; i < dates.size(); i++)
+		if (parse(dates[i].c_str(), timeKey))
+			checksum += timeKey;
+	std::chrono::high_resolution_clock::time_point stop = std::chrono::high_resolution_clock::now();
+
+	double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+	printf("%-12s %10.2f ms per million dates (checksum %lld)\n", name, ms * 1000000.0 / dates.size(), checksum);
+}
+
+bool parseWithDateParser(const char* date, int& timeKey)
+{
+	return DateParser::parse(date, timeKey) == DateParser::DATE_OK;
+}
+
+int main(int argc, char** argv)
+{
+	size_t count = (argc > 1 ? (size_t) atoll(argv[1]) : 1000000);
+
+	std::vector<std::string> dates(count);
+	char buffer[32];
+	srand(42);
+	for (size_t i = 0; i < count; i++)
+	{
+		sprintf(buffer, "%02d.%02d.%04d. %02d:%02d", rand() % 28 + 1, rand() % 12 + 1, 1970 + rand() % 100,
+			rand() % 24, rand() % 60);
+		dates[i] = buffer;
+	}
+
+	measure("stringstream", dates, &parseWithStream);
+	measure("DateParser", dates, &parseWithDateParser);
+
+	return 0;
+}
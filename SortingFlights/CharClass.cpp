@@ -0,0 +1,61 @@
+#include "CharClass.h"
+
+#define A CharClass::ALPHA
+#define D CharClass::DIGIT
+#define S CharClass::SPACE
+#define P CharClass::PUNCT
+#define R CharClass::SEPARATOR
+#define L CharClass::DELIMITER
+#define U CharClass::UTF8
+
+/*
+	Table of class bits, one row per 16 byte values (first value of row is written in comment).
+	VS2013 has no constexpr, so table is plain constant array, initialized at compile time.
+*/
+const unsigned char CharClass::TABLE[256] =
+{
+	/* 00 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, S, L, 0, 0, 0, 0, 0,
+	/* 10 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	/* 20 */ S|R, P, P, P, P, P, P, P, P, P, P, P, P, P, P|R, P,
+	/* 30 */ D, D, D, D, D, D, D, D, D, D, P|R, L, P, P, P, P,
+	/* 40 */ P, A, A, A, A, A, A, A, A, A, A, A, A, A, A, A,
+	/* 50 */ A, A, A, A, A, A, A, A, A, A, A, P, P, P, P, P,
+	/* 60 */ P, A, A, A, A, A, A, A, A, A, A, A, A, A, A, A,
+	/* 70 */ A, A, A, A, A, A, A, A, A, A, A, P, P, P, P, 0,
+	/* 80 */ U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,
+	/* 90 */ U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,
+	/* A0 */ U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,
+	/* B0 */ U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,
+	/* C0 */ U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,
+	/* D0 */ U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,
+	/* E0 */ U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,
+	/* F0 */ U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U
+};
+
+#undef A
+#undef D
+#undef S
+#undef P
+#undef R
+#undef L
+#undef U
+
+/*
+	Function which checks whole buffer against mask.
+
+	Chars are not checked one by one with early exit, each one adds one bit (is it outside mask)
+	into result, so loop has no branches except loop condition.
+
+	@param pos -> (const char *) begining of buffer.
+	@param end -> (const char *) end of buffer.
+	@param mask -> (unsigned char) mask of accepted classes.
+
+	@return (bool) true if every char belongs to any of classes in mask (or buffer is empty).
+*/
+bool CharClass::all(const char* pos, const char* end, unsigned char mask)
+{
+	unsigned bad = 0;
+	for (; pos != end; ++pos)
+		bad |= (TABLE[(unsigned char) *pos] & mask) == 0;
+	return bad == 0;
+}
@@ -0,0 +1,56 @@
+#ifndef _CHAR_CLASS_INCLUDED_
+#define _CHAR_CLASS_INCLUDED_
+
+/*
+	Namespace designed for classification of characters with one table lookup.
+
+	Each of 256 byte values has its class bits in CharClass::TABLE, so checking if char belongs to
+	any set of classes is one lookup and one and, instead of chain of range comparisons. All parsers
+	(StreamReader field types, Flight::tryParse, DateParser) validate characters through this table.
+	Sets of classes accepted by fields are plain masks, so field can be configured by changing mask
+	(e.g. Flight::destinationClasses accepts UTF-8 bytes).
+
+	@author Acko.
+*/
+namespace CharClass
+{
+	/*
+		Class bits:
+			ALPHA		-> english alphabet letter.
+			DIGIT		-> '0' - '9'.
+			SPACE		-> ' ' or tab.
+			PUNCT		-> printable ASCII character which is not letter or digit (except ';').
+			SEPARATOR	-> '.', ':' or ' ' (separators inside date).
+			DELIMITER	-> field or row delimiter (';', new line).
+			UTF8		-> byte of multi byte UTF-8 character (0x80 - 0xFF).
+	*/
+	enum { ALPHA = 0x01, DIGIT = 0x02, SPACE = 0x04, PUNCT = 0x08, SEPARATOR = 0x10, DELIMITER = 0x20, UTF8 = 0x40 };
+
+	/*
+		Masks of fields:
+			CHAR	-> 'c' pattern type (english alphabet letter, '.', ':' or ' ').
+			NUM		-> 'd' pattern type (digit).
+			TEXT	-> any printable ASCII character except delimiters.
+	*/
+	enum { CHAR = ALPHA | SEPARATOR, NUM = DIGIT, TEXT = ALPHA | DIGIT | SPACE | PUNCT };
+
+	/*
+		Table of class bits for each byte value.
+	*/
+	extern const unsigned char TABLE[256];
+
+	/*
+		Function which returns true if char belongs to any of classes in mask.
+	*/
+	inline bool is(char c, unsigned char mask)
+	{
+		return (TABLE[(unsigned char) c] & mask) != 0;
+	}
+
+	/*
+		Function which returns true if all chars of buffer belong to any of classes in mask.
+	*/
+	bool all(const char *, const char *, unsigned char);
+};
+
+#endif
@@ -0,0 +1,106 @@
+#include "DateParser.h"
+#include "Flight.h"
+#include "CharClass.h"
+
+#include <cstring>
+
+typedef unsigned long long Word;
+
+/*
+	Local function which loads 8 bytes from (possibly unaligned) position into one word.
+
+	@param pos -> (const char *) position of first byte.
+
+	@return (Word) loaded bytes, first byte is lowest one.
+*/
+inline Word load(const char* pos)
+{
+	Word word;
+	memcpy(&word, pos, sizeof(word));
+	return word;
+}
+
+/*
+	Local function which checks digits of one word, and joins them into two digit numbers.
+
+	Bytes selected by mask must be digits, '0' is removed from them with xor (which leaves 0 - 9 for
+	digits and 10 - 255 for anything else), and byte is not digit if adding 6 moves it past 15.
+	After that bytes out of mask are cleared, and each byte is multiplied by 10 and added to next one,
+	so byte i of result is two digit number made of digits i and i + 1 (no carry is possible, 99 fits in byte).
+
+	@param word		-> (Word) loaded bytes.
+	@param mask		-> (Word) 0xFF in bytes which must be digits, 0 in others.
+	@param pairs	-> (Word&) joined pairs of digits.
+
+	@return (bool) true if all bytes selected by mask are digits, false otherwise.
+*/
+inline bool toPairs(Word word, Word mask, Word& pairs)
+{
+	const Word ZEROS = 0x3030303030303030ULL, LOW = 0x7F7F7F7F7F7F7F7FULL,
+		SIX = 0x0606060606060606ULL, HIGH = 0xF0F0F0F0F0F0F0F0ULL;
+
+	word ^= ZEROS;
+	if (((word | ((word & LOW) + SIX)) & HIGH & mask) != 0)
+		return false;
+
+	word &= mask;
+	pairs = word * 10 + (word >> 8);
+	return true;
+}
+
+/*
+	Local function which returns byte of word.
+
+	@param word		-> (Word) word.
+	@param index	-> (int) index of byte (0 is lowest).
+
+	@return (int) value of byte.
+*/
+inline int byteAt(Word word, int index)
+{
+	return (int) ((word >> (index * 8)) & 0xFF);
+}
+
+/*
+	Function which parses flight time field "dd.mm.yyyy. HH:MM" and stores packed time key.
+
+	Three overlapping words are loaded: "dd.mm.yy" (from 0), "yyyy. HH" (from 6) and "y. HH:MM" (from 9),
+	which together cover all twelve digits, so day, month, both halves of year, hour and minute
+	are all pairs inside one of words. Separators are checked with CharClass table (same class as
+	'c' pattern type in Flight::operator>>). Range check is same as in Flight::operator>>.
+
+	@param date		-> (const char *) begining of field, at least 17 chars must be readable.
+	@param timeKey	-> (int&) packed time key (Flight::toTimeKey), set only if field is valid.
+
+	@return (int) DATE_OK if field is valid, DATE_BAD_FORMAT if digits or separators are wrong,
+		DATE_OUT_OF_RANGE if numbers are too big.
+*/
+int DateParser::parse(const char* date, int& timeKey)
+{
+	//	byte:	 0 1 2 3 4 5 6 7
+	//	first	 d d . m m . y y
+	//	middle	 y y y y . _ H H
+	//	last	 y . _ H H : M M
+	const Word FIRST_DIGITS = 0xFFFF00FFFF00FFFFULL, MIDDLE_DIGITS = 0xFFFF0000FFFFFFFFULL,
+		LAST_DIGITS = 0xFFFF00FFFF0000FFULL;
+
+	Word first, middle, last;
+	if (!toPairs(load(date), FIRST_DIGITS, first) ||
+		!toPairs(load(date + 6), MIDDLE_DIGITS, middle) ||
+		!toPairs(load(date + 9), LAST_DIGITS, last))
+		return DATE_BAD_FORMAT;
+
+	if (!CharClass::is(date[2], CharClass::CHAR) || !CharClass::is(date[5], CharClass::CHAR) ||
+		!CharClass::is(date[10], CharClass::CHAR) || !CharClass::is(date[11], CharClass::CHAR) ||
+		!CharClass::is(date[14], CharClass::CHAR))
+		return DATE_BAD_FORMAT;
+
+	int day = byteAt(first, 0), month = byteAt(first, 3), year = byteAt(middle, 0) * 100 + byteAt(middle, 2),
+		hour = byteAt(last, 3), minute = byteAt(last, 6);
+
+	if (day > 31 || month > 12 || year > 2100 || hour > 23 || minute > 60)
+		return DATE_OUT_OF_RANGE;
+
+	timeKey = Flight::toTimeKey(day, month, year, hour, minute);
+	return DATE_OK;
+}
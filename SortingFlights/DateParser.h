@@ -0,0 +1,29 @@
+#ifndef _DATE_PARSER_INCLUDED_
+#define _DATE_PARSER_INCLUDED_
+
+/*
+	Namespace designed for parsing fixed width flight time field "dd.mm.yyyy. HH:MM" (17 chars).
+
+	Field is not read char by char (or through stream), it is loaded with three overlapping 64-bit
+	loads, all twelve digits are validated with few mask operations over whole words (SWAR), and
+	pairs of digits are joined into two digit numbers with one multiply per word. Result is packed
+	time key (see Flight::toTimeKey), so caller never touches separate numbers.
+
+	Loads assume little endian byte order (x86 and x64, which are only targets of this project).
+
+	@author Acko.
+*/
+namespace DateParser
+{
+	/*
+		Enumeration of results of DateParser::parse().
+	*/
+	enum { DATE_OK = 0, DATE_BAD_FORMAT, DATE_OUT_OF_RANGE };
+
+	/*
+		Function which parses 17 chars of flight time and stores packed time key. Returns status (enumeration).
+	*/
+	int parse(const char *, int&);
+};
+
+#endif
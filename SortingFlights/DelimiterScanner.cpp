@@ -0,0 +1,141 @@
+#include "DelimiterScanner.h"
+
+#if defined(__AVX2__)
+#define SCANNER_AVX2
+#include <immintrin.h>
+#elif defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define SCANNER_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/*
+	Local function which returns index of lowest set bit in mask (mask must not be 0).
+
+	@param mask -> (unsigned) bit mask.
+
+	@return (int) index of lowest set bit.
+*/
+inline int lowestBit(unsigned mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return (int) index;
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+
+/*
+	Local function which returns number of set bits in mask.
+
+	@param mask -> (unsigned) bit mask.
+
+	@return (int) number of set bits.
+*/
+inline int bitCount(unsigned mask)
+{
+	int bits = 0;
+	for (; mask != 0; mask &= mask - 1)
+		bits++;
+	return bits;
+}
+
+#if defined(SCANNER_AVX2)
+	static const int BLOCK = 32;
+	typedef __m256i Block;
+	#define LOAD(p) _mm256_loadu_si256((const __m256i *) (p))
+	#define SPLAT(c) _mm256_set1_epi8(c)
+	#define EQUAL(a, b) _mm256_cmpeq_epi8(a, b)
+	#define OR(a, b) _mm256_or_si256(a, b)
+	#define MASK(a) ((unsigned) _mm256_movemask_epi8(a))
+#elif defined(SCANNER_SSE2)
+	static const int BLOCK = 16;
+	typedef __m128i Block;
+	#define LOAD(p) _mm_loadu_si128((const __m128i *) (p))
+	#define SPLAT(c) _mm_set1_epi8(c)
+	#define EQUAL(a, b) _mm_cmpeq_epi8(a, b)
+	#define OR(a, b) _mm_or_si128(a, b)
+	#define MASK(a) ((unsigned) _mm_movemask_epi8(a))
+#endif
+
+/*
+	Function which returns position of first occurance of char in buffer.
+
+	@param pos -> (const char *) begining of buffer.
+	@param end -> (const char *) end of buffer.
+	@param c -> (char) char which is searched.
+
+	@returns (const char *) position of first occurance of c, or end if there is none.
+*/
+const char* DelimiterScanner::find(const char* pos, const char* end, char c)
+{
+#if defined(SCANNER_AVX2) || defined(SCANNER_SSE2)
+	Block wanted = SPLAT(c);
+	for (; end - pos >= BLOCK; pos += BLOCK)
+	{
+		unsigned mask = MASK(EQUAL(LOAD(pos), wanted));
+		if (mask != 0)
+			return pos + lowestBit(mask);
+	}
+#endif
+	for (; pos != end; ++pos)
+		if (*pos == c)
+			return pos;
+	return end;
+}
+
+/*
+	Function which returns position of first occurance of any of two chars in buffer.
+
+	@param pos -> (const char *) begining of buffer.
+	@param end -> (const char *) end of buffer.
+	@param c1 -> (char) first char which is searched.
+	@param c2 -> (char) second char which is searched.
+
+	@returns (const char *) position of first occurance of c1 or c2, or end if there is none.
+*/
+const char* DelimiterScanner::findEither(const char* pos, const char* end, char c1, char c2)
+{
+#if defined(SCANNER_AVX2) || defined(SCANNER_SSE2)
+	Block wanted1 = SPLAT(c1), wanted2 = SPLAT(c2);
+	for (; end - pos >= BLOCK; pos += BLOCK)
+	{
+		Block block = LOAD(pos);
+		unsigned mask = MASK(OR(EQUAL(block, wanted1), EQUAL(block, wanted2)));
+		if (mask != 0)
+			return pos + lowestBit(mask);
+	}
+#endif
+	for (; pos != end; ++pos)
+		if (*pos == c1 || *pos == c2)
+			return pos;
+	return end;
+}
+
+/*
+	Function which returns number of occurances of char in buffer.
+
+	@param pos -> (const char *) begining of buffer.
+	@param end -> (const char *) end of buffer.
+	@param c -> (char) char which is counted.
+
+	@returns (size_t) number of occurances of c.
+*/
+size_t DelimiterScanner::count(const char* pos, const char* end, char c)
+{
+	size_t found = 0;
+#if defined(SCANNER_AVX2) || defined(SCANNER_SSE2)
+	Block wanted = SPLAT(c);
+	for (; end - pos >= BLOCK; pos += BLOCK)
+		found += bitCount(MASK(EQUAL(LOAD(pos), wanted)));
+#endif
+	for (; pos != end; ++pos)
+		if (*pos == c)
+			found++;
+	return found;
+}
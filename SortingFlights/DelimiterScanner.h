@@ -0,0 +1,34 @@
+#ifndef _DELIMITER_SCANNER_INCLUDED_
+#define _DELIMITER_SCANNER_INCLUDED_
+
+#include <cstddef>
+
+/*
+	Namespace designed for fast searching of field (';') and row ('\n') delimiters inside char buffers.
+
+	When compiler targets SSE2 (always on x64, /arch:SSE2 on x86) or AVX2 (/arch:AVX2), buffer is
+	checked 16 (32) bytes at a time, by comparing whole block with delimiter and reading positions
+	of matches from bit mask. Otherwise (and for last bytes of buffer which don't fill whole block)
+	it is checked char by char. Functions never read past end of buffer.
+
+	@author Acko.
+*/
+namespace DelimiterScanner
+{
+	/*
+		Function which returns position of first occurance of char in buffer, or end of buffer if there is none.
+	*/
+	const char* find(const char *, const char *, char);
+
+	/*
+		Function which returns position of first occurance of any of two chars in buffer, or end of buffer if there is none.
+	*/
+	const char* findEither(const char *, const char *, char, char);
+
+	/*
+		Function which returns number of occurances of char in buffer.
+	*/
+	size_t count(const char *, const char *, char);
+};
+
+#endif
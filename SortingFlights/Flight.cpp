@@ -1,48 +1,120 @@
 #include "Flight.h"
+#include "DelimiterScanner.h"
+#include "DateParser.h"
+#include "CharClass.h"
 
 /*
-	Base constructor
+	Local function which returns how many characters of text fit into fixed width array. If text is cut,
+	it is never cut inside multi byte UTF-8 character (continuation bytes of last character are dropped too).
+
+	@param text		-> (const char *) text.
+	@param length	-> (int) length of text.
+	@param size		-> (int) maximum number of characters.
 
-	It sets flightLoaded flag to false, and allocates new character string on heap, for
-	instances string representation.
+	@return (int) number of characters which should be copied.
 */
-Flight::Flight()
-	: flightLoaded(false)
+int fitLength(const char* text, int length, int size)
+{
+	if (length <= size)
+		return length;
+
+	length = size;
+	while (length > 0 && ((unsigned char) text[length] & 0xC0) == 0x80)
+		length--;
+	return length;
+}
+
+/*
+	Local function which copies string into fixed width char array of Flight instance.
+	It copies at most size characters and always null terminates destination array.
+
+	@param dst	-> (char *) destination array (must have place for size + 1 characters).
+	@param src	-> (const std::string&) string which should be copied.
+	@param size	-> (int) maximum number of characters to copy.
+*/
+void copyField(char* dst, const std::string& src, int size)
+{
+	int length = fitLength(src.c_str(), (int) src.length(), size);
+	memcpy(dst, src.c_str(), length);
+	dst[length] = '\0';
+}
+
+/*
+	Local function which checks if characters in buffer match fixed width pattern.
+	Pattern uses same letters as StreamReader field types ('c' - char, 'd' - digit).
+
+	@param pos		-> (const char *) position in buffer from which pattern is checked.
+	@param end		-> (const char *) end of buffer (pattern must fit before it).
+	@param pattern	-> (const char *) pattern which should be matched.
+
+	@return (bool) true if buffer matches pattern, false otherwise.
+*/
+bool matchPattern(const char* pos, const char* end, const char* pattern)
+{
+	for (; *pattern != '\0'; ++pattern, ++pos)
+		if (pos == end || !CharClass::is(*pos, *pattern == 'd' ? CharClass::NUM : CharClass::CHAR))
+			return false;
+	return true;
+}
+
+/*
+	Local function which returns position right after field delimiter (';') which follows given position
+	(same as StreamReader::clearStream does for streams, but it never goes past end of row).
+
+	@param pos			-> (const char *) position from which delimiter is searched.
+	@param end			-> (const char *) end of buffer.
+
+	@return (const char *) position right after delimiter, or nullptr if row (or buffer) ends before delimiter.
+*/
+const char* skipField(const char* pos, const char* end)
 {
-	 stringRepresentation = new char[Flight::STRING_REPRESENTATION_SIZE];
+	const char* found = DelimiterScanner::findEither(pos, end, ';', '\n');
+	if (found == end || *found != ';')
+		return nullptr;
+	return found + 1;
 }
 
 /*
-	Copy constructor.
+	Local function which returns begining of row which follows given position.
 
-	It provied deep copy.
+	@param pos			-> (const char *) position inside row.
+	@param end			-> (const char *) end of buffer.
+
+	@return (const char *) begining of next row (or end of buffer).
 */
-Flight::Flight(Flight& org)
-	: flightLoaded(false)
+const char* skipRow(const char* pos, const char* end)
 {
-	stringRepresentation = new char[Flight::STRING_REPRESENTATION_SIZE];
-	destination = org.getDestination();
-	flightTime = org.getFlightTime();
-	flightNumber = org.getFlightNumber();
-	gateNumber = org.getGateNumber();
+	pos = DelimiterScanner::find(pos, end, '\n');
+	return (pos == end ? end : pos + 1);
 }
 
 /*
-	Destructor.
+	Destination accepts any printable ASCII character and UTF-8 characters by default.
+*/
+unsigned char Flight::destinationClasses = CharClass::TEXT | CharClass::UTF8;
+
+/*
+	Base constructor
 
-	Clean heap memory alocated by Flight constructor.
+	It sets flightLoaded flag to false, and empties all properties. No heap memory is used,
+	instance is trivially copyable.
 */
-Flight::~Flight()
+Flight::Flight()
+	: flightLoaded(false), timeKey(0)
 {
-	delete stringRepresentation;
+	stringRepresentation[0] = '\0';
+	destination[0] = '\0';
+	flightTime[0] = '\0';
+	flightNumber[0] = '\0';
+	gateNumber[0] = '\0';
 }
 
 /*
 	Getter method for destination property.
 
-	@return (std::string) destination information.
+	@return (const char *) destination information.
 */
-std::string Flight::getDestination() const
+const char* Flight::getDestination() const
 {
 	return this -> destination;
 }
@@ -50,9 +122,9 @@ std::string Flight::getDestination() const
 /*
 	Getter method for flight time property.
 
-	@return (std::string) flight time information.
+	@return (const char *) flight time information.
 */
-std::string Flight::getFlightTime() const
+const char* Flight::getFlightTime() const
 {
 	return this -> flightTime;
 }
@@ -60,9 +132,9 @@ std::string Flight::getFlightTime() const
 /*
 	Getter method for flight number property.
 
-	@return (std::string) flight number information.
+	@return (const char *) flight number information.
 */
-std::string Flight::getFlightNumber() const
+const char* Flight::getFlightNumber() const
 {
 	return this -> flightNumber;
 }
@@ -70,13 +142,49 @@ std::string Flight::getFlightNumber() const
 /*
 	Getter method for gate number property.
 
-	@return (std::string) gate number information.
+	@return (const char *) gate number information.
 */
-std::string Flight::getGateNumber() const
+const char* Flight::getGateNumber() const
 {
 	return this -> gateNumber;
 }
 
+/*
+	Getter method for packed flight time key.
+
+	@return (int) minutes since 01.01.1970. 00:00 (see Flight::toTimeKey).
+*/
+int Flight::getTimeKey() const
+{
+	return this -> timeKey;
+}
+
+/*
+	Function which packs date and time into one integer, number of minutes since 01.01.1970. 00:00.
+
+	Day number is calculated by civil calendar (year shifted so that it starts in March, so leap day
+	is last day of year), so that keys of two dates compare same as dates themselves.
+
+	@param day		-> (int) day of month (1 - 31).
+	@param month	-> (int) month (1 - 12).
+	@param year		-> (int) year.
+	@param hour		-> (int) hour (0 - 23).
+	@param minute	-> (int) minute (0 - 59).
+
+	@return (int) packed time key.
+*/
+int Flight::toTimeKey(int day, int month, int year, int hour, int minute)
+{
+	year -= month <= 2;
+	int era = (year >= 0 ? year : year - 399) / 400;
+	int yearOfEra = year - era * 400;
+	int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+	int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+	int days = era * 146097 + dayOfEra - 719468;
+
+	return (days * 24 + hour) * 60 + minute;
+}
+
 /*
 	Function that reads stream and gets Destination information (returns as a std::string)
 	if anything goes wrong while reading it throws std::exception. It uses StreamReader namespace.
@@ -89,13 +197,15 @@ std::string Flight::getGateNumber() const
 */
 std::string Flight::readDestination(std::istream& _in)
 {
-	StreamReader::InputType it("s", Flight::MAX_STRING_SIZE, ';');
-	StreamReader::UserObject* uo = StreamReader::readStream(_in, it);
+	typedef StreamReader::Pattern<StreamReader::String<Flight::MAX_STRING_SIZE, ';'> > DestinationPattern;
 
-	std::string ret = std::string(* (std::string*) uo -> data[0]);
-	delete uo;
+	DestinationPattern::Result result = DestinationPattern::read(_in);
+	const StreamReader::Text<Flight::MAX_STRING_SIZE>& destination = std::get<0>(result);
 
-	return ret;
+	if (!CharClass::all(destination.text, destination.text + destination.length, destinationClasses))
+		throw std::exception("Bad input file!");
+
+	return std::string(destination.text, destination.length);
 }
 
 /*
@@ -103,35 +213,29 @@ std::string Flight::readDestination(std::istream& _in)
 	format of reading is "dd.mm.yyyy HH:MM", and it must be followed or this function will throw error.
 	if anything goes wrong while reading it throws std::exception. It uses StreamReader namespace.
 
+	Numbers parsed here are also packed into time key (DateParser::parse, Flight::toTimeKey), so that
+	they are parsed only once, when loading.
+
 	@param _in				-> (std::istream&) stream which is used for reading.
+	@param _timeKey			-> (int&) packed time key of date read.
 
 	@throws std::exception	-> if reading goes wrong.
 
 	@return (std::string) content read from input stream (stored in buffer)
 */
-std::string Flight::readDate(std::istream& _in)
+std::string Flight::readDate(std::istream& _in, int& _timeKey)
 {
-	StreamReader::InputType it("ddcddcddddccddcdd", Flight::MAX_STRING_SIZE, ';');
-	StreamReader::UserObject* uo = StreamReader::readStream(_in, it);
-
-	char buffer[DATE_SIZE + 1];
-	for (int i = 0; i < DATE_SIZE; i++)
-		buffer[i] = * (char *) uo -> data[i];
-
-	delete uo;
-	buffer[DATE_SIZE] = '\0';
+	using StreamReader::Char;
+	using StreamReader::Digit;
 
-	std::stringstream ss;
-	ss << buffer;
+	// "ddcddcddddccddcdd"
+	typedef StreamReader::Pattern<Digit, Digit, Char, Digit, Digit, Char, Digit, Digit, Digit, Digit,
+									Char, Char, Digit, Digit, Char, Digit, Digit> DatePattern;
 
-	char temp;
-	int day, month, year, hour, minute;
-	ss >> day >> temp >> month >> temp >> year >> temp >> hour >> temp >> minute;
-
-	if (ss.fail())
-		throw std::exception("Bad input file!");
+	char buffer[DATE_SIZE + 1];
+	StreamReader::copyChars(DatePattern::read(_in), buffer);
 
-	if (day > 31 || month > 12 || year > 2100 || hour > 23 || minute > 60)
+	if (DateParser::parse(buffer, _timeKey) != DateParser::DATE_OK)
 		throw std::exception("Bad input file!");
 
 	StreamReader::clearStream(_in, ';');
@@ -152,15 +256,14 @@ std::string Flight::readDate(std::istream& _in)
 */
 std::string Flight::readFlightNumber(std::istream& _in)
 {
-	StreamReader::InputType it("ccddd");
-	StreamReader::UserObject* uo = StreamReader::readStream(_in, it);
+	using StreamReader::Char;
+	using StreamReader::Digit;
+
+	typedef StreamReader::Pattern<Char, Char, Digit, Digit, Digit> FlightNumberPattern;
 
-	char buffer[6];
-	for (int i = 0; i < 5; i++)
-		buffer[i] = * (char*) uo -> data[i];
-	buffer[5] = '\0';
+	char buffer[FN_SIZE + 1];
+	StreamReader::copyChars(FlightNumberPattern::read(_in), buffer);
 
-	delete uo;
 	StreamReader::clearStream(_in, ';');
 
 	return std::string(buffer);
@@ -179,36 +282,27 @@ std::string Flight::readFlightNumber(std::istream& _in)
 */
 std::string Flight::readGateNumber(std::istream& _in)
 {
-	StreamReader::InputType it("cd");
-	StreamReader::UserObject* uo = StreamReader::readStream(_in, it);
+	typedef StreamReader::Pattern<StreamReader::Char, StreamReader::Digit> GateNumberPattern;
+
+	char buffer[GN_SIZE + 1];
+	StreamReader::copyChars(GateNumberPattern::read(_in), buffer);
 
-	char buffer[3];
-	for (int i = 0; i < 2; i++)
-		buffer[i] = * (char*) uo -> data[i];
-	buffer[2] = '\0';
-	
-	delete uo;
 	return std::string(buffer);
 }
 
 /*
 	This function is designed to create string representation of Flight instance.
 
-	It is done only once (first time function is called - in operator>>), it fills instance's
-	stringRepresentation array (on heap), and every next time it just return's pointer to that
-	char array. Data filled here is deallocated in destructor of Flight instance.
-
-	@return -> pointer to char array (on heap) with string representation of instance.
-
-	@note -> shouldn't be manually deleted (It is handled by object Constructor/Destructor pair).
+	It is done only once (when instance is read - in operator>>), it fills instance's
+	stringRepresentation array, which is then returned by Flight::toString().
 */
-const char* Flight::toString() const
+void Flight::render()
 {
 	if (!flightLoaded)
 	{
 		int currPos = 0;
 
-		int length = destination.length();
+		int length = (int) strlen(destination);
 		int left = (DEST_SIZE - length) / 2;
 
 		stringRepresentation[currPos++] = ' ';
@@ -230,10 +324,14 @@ const char* Flight::toString() const
 		}
 		else
 		{
-			for (int i = 0; i < DEST_SIZE - 3; i++)
+			// cut is not made inside UTF-8 character, dropped bytes are filled with spaces (width stays same)
+			int cut = fitLength(destination, length, DEST_SIZE - 3);
+			for (int i = 0; i < cut; i++)
 				stringRepresentation[currPos++] = destination[i];
 			for (int i = 0; i < 3; i++)
 				stringRepresentation[currPos++] = '.';
+			for (int i = cut; i < DEST_SIZE - 3; i++)
+				stringRepresentation[currPos++] = ' ';
 		}
 
 		stringRepresentation[currPos++] = ' ';
@@ -254,13 +352,23 @@ const char* Flight::toString() const
 		stringRepresentation[currPos++] = '\n';
 		stringRepresentation[currPos++] = '\0';
 	}
+}
+
+/*
+	Function which return's pointer to string representation of Flight instance.
+
+	@return -> pointer to char array (inside instance) with string representation of instance.
 
+	@note -> shouldn't be changed or deleted (it is part of instance).
+*/
+const char* Flight::toString() const
+{
 	return stringRepresentation;
 }
 
 /*
 	Overloaded operator for reading object from some input stream.
-	If reading went well (no exception raised), Flight::toString() is called, for current instance
+	If reading went well (no exception raised), Flight::render() is called, for current instance
 	(so it will create initial self stringRepresentation) and it's flightLoaded flag is set to true.
 
 	@param _in				-> (std::istream&) input stream from which instance information should be read.
@@ -272,15 +380,187 @@ const char* Flight::toString() const
 */
 std::istream& operator>>(std::istream& _in, Flight& _f)
 {
-	_f.destination = Flight::readDestination(_in);
-	_f.flightTime = Flight::readDate(_in);
-	_f.flightNumber = Flight::readFlightNumber(_in);
-	_f.gateNumber = Flight::readGateNumber(_in);
+	_f.flightLoaded = false;
+
+	copyField(_f.destination, Flight::readDestination(_in), Flight::DEST_SIZE);
+	copyField(_f.flightTime, Flight::readDate(_in, _f.timeKey), Flight::DATE_SIZE);
+	copyField(_f.flightNumber, Flight::readFlightNumber(_in), Flight::FN_SIZE);
+	copyField(_f.gateNumber, Flight::readGateNumber(_in), Flight::GN_SIZE);
 
-	StreamReader::clearStream(_in);
+	// last row in file doesn't have to end with new line
+	if (_in.peek() != EOF)
+		StreamReader::clearStream(_in);
 
-	_f.toString();
+	_f.render();
 	_f.flightLoaded = true;
 
 	return _in;
-}
\ No newline at end of file
+}
+
+/*
+	Function which reads one Flight (one row) directly from char buffer (e.g. memory mapped file).
+
+	It is throwing interface for Flight::tryParse(), see it for details.
+
+	@param pos				-> (const char *) begining of row in buffer.
+	@param end				-> (const char *) end of buffer.
+	@param _f				-> (Flight&) reference to an object which should be filled with information.
+
+	@throws std::exception	-> if row doesn't match format.
+
+	@return (const char *) begining of next row (or end of buffer).
+*/
+const char* Flight::parse(const char* pos, const char* end, Flight& _f)
+{
+	const char* next;
+	if (tryParse(pos, end, _f, &next) != PARSE_OK)
+		throw std::exception("Bad input file!");
+	return next;
+}
+
+/*
+	Function which reads one Flight (one row) directly from char buffer, without throwing exceptions.
+
+	Row format and validation are same as in operator>> (destination;date;flight number;gate number),
+	but fields are checked and copied straight from buffer into Flight instance, without any allocation
+	or stream calls. Field and row borders are found with DelimiterScanner (many bytes at a time), date
+	is parsed with DateParser (few 64-bit words instead of char by char), and
+	search for field delimiter stops on end of row, so broken row can't swallow next one.
+	Last row doesn't have to end with new line.
+
+	Begining of next row is always stored in last parameter, so caller can skip invalid row and continue.
+	If row is not valid, Flight instance is left partly filled (and not loaded).
+
+	@param pos				-> (const char *) begining of row in buffer.
+	@param end				-> (const char *) end of buffer.
+	@param _f				-> (Flight&) reference to an object which should be filled with information.
+	@param next				-> (const char **) pointer in which begining of next row (or end of buffer) is stored.
+
+	@return (int) PARSE_OK if row is valid, otherwise enumeration of first field which is not valid.
+*/
+int Flight::tryParse(const char* pos, const char* end, Flight& _f, const char** next)
+{
+	_f.flightLoaded = false;
+
+	// destination, at most MAX_STRING_SIZE - 2 characters followed by ';'
+	const char* field = pos;
+	pos = skipField(pos, end);
+	if (pos == nullptr || pos - 1 - field > MAX_STRING_SIZE - 2)
+	{
+		*next = skipRow(pos == nullptr ? field : pos, end);
+		return BAD_DESTINATION;
+	}
+
+	if (!CharClass::all(field, pos - 1, destinationClasses))
+	{
+		*next = skipRow(pos, end);
+		return BAD_DESTINATION;
+	}
+
+	int length = fitLength(field, (int) (pos - 1 - field), DEST_SIZE);
+	memcpy(_f.destination, field, length);
+	_f.destination[length] = '\0';
+
+	// date "dd.mm.yyyy. HH:MM"
+	int status = (end - pos >= DATE_SIZE ? DateParser::parse(pos, _f.timeKey) : DateParser::DATE_BAD_FORMAT);
+	if (status != DateParser::DATE_OK)
+	{
+		*next = skipRow(pos, end);
+		return (status == DateParser::DATE_OUT_OF_RANGE ? DATE_OUT_OF_RANGE : BAD_DATE);
+	}
+
+	memcpy(_f.flightTime, pos, DATE_SIZE);
+	_f.flightTime[DATE_SIZE] = '\0';
+
+	field = pos + DATE_SIZE;
+	pos = skipField(field, end);
+	if (pos == nullptr)
+	{
+		*next = skipRow(field, end);
+		return BAD_DATE;
+	}
+
+	// flight number "ccddd"
+	field = pos;
+	if (!matchPattern(pos, end, "ccddd") || (pos = skipField(pos + FN_SIZE, end)) == nullptr)
+	{
+		*next = skipRow(field, end);
+		return BAD_FLIGHT_NUMBER;
+	}
+
+	memcpy(_f.flightNumber, field, FN_SIZE);
+	_f.flightNumber[FN_SIZE] = '\0';
+
+	// gate number "cd", rest of row is ignored
+	if (!matchPattern(pos, end, "cd"))
+	{
+		*next = skipRow(pos, end);
+		return BAD_GATE_NUMBER;
+	}
+
+	memcpy(_f.gateNumber, pos, GN_SIZE);
+	_f.gateNumber[GN_SIZE] = '\0';
+
+	_f.render();
+	_f.flightLoaded = true;
+
+	*next = skipRow(pos + GN_SIZE, end);
+	return PARSE_OK;
+}
+
+/*
+	Function which returns description of Flight::tryParse() status.
+
+	@param status -> (int) status returned by Flight::tryParse().
+
+	@return (const char *) description of status (static string).
+*/
+const char* Flight::statusMessage(int status)
+{
+	switch (status)
+	{
+	case PARSE_OK:
+		return "Row is valid.";
+	case BAD_DESTINATION:
+		return "Destination is missing, too long or has characters which are not allowed.";
+	case BAD_DATE:
+		return "Flight time doesn't match \"dd.mm.yyyy. HH:MM\" format.";
+	case DATE_OUT_OF_RANGE:
+		return "Flight time is out of range.";
+	case BAD_FLIGHT_NUMBER:
+		return "Flight number doesn't match \"ccddd\" format.";
+	case BAD_GATE_NUMBER:
+		return "Gate number doesn't match \"cd\" format.";
+	default:
+		return "Unknown error.";
+	}
+}
+/*
+	Function which fills instance from properties which are already valid (e.g. read from binary
+	file, see FlightBinary), so nothing is checked or parsed, properties are only copied.
+
+	@param _destination		-> (const char *) null terminated destination (cut to DEST_SIZE characters).
+	@param _flightTime		-> (const char *) flight time, DATE_SIZE characters.
+	@param _timeKey			-> (int) packed time key of flight time (Flight::toTimeKey).
+	@param _flightNumber	-> (const char *) flight number, FN_SIZE characters.
+	@param _gateNumber		-> (const char *) gate number, GN_SIZE characters.
+*/
+void Flight::set(const char* _destination, const char* _flightTime, int _timeKey, const char* _flightNumber,
+				const char* _gateNumber)
+{
+	int length = fitLength(_destination, (int) strlen(_destination), DEST_SIZE);
+	memcpy(this -> destination, _destination, length);
+	this -> destination[length] = '\0';
+
+	memcpy(this -> flightTime, _flightTime, DATE_SIZE);
+	this -> flightTime[DATE_SIZE] = '\0';
+	memcpy(this -> flightNumber, _flightNumber, FN_SIZE);
+	this -> flightNumber[FN_SIZE] = '\0';
+	memcpy(this -> gateNumber, _gateNumber, GN_SIZE);
+	this -> gateNumber[GN_SIZE] = '\0';
+	this -> timeKey = _timeKey;
+
+	this -> flightLoaded = false;
+	render();
+	this -> flightLoaded = true;
+}
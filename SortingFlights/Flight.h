@@ -2,6 +2,7 @@
 #define _FLIGHT_INCLUDED_
 
 #include <string>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include "StreamReader.h"
@@ -15,36 +16,65 @@
 */
 class Flight
 {
+public:
+	/*
+		Constant which limits maximum number of characters in each string property
+	*/
+	static const int MAX_STRING_SIZE = 100;
+
+	/*
+		Constants defining how many character size is for which string
+	*/
+	static const int FN_SIZE = 5, GN_SIZE = 2, DATE_SIZE = 17, DEST_SIZE = 20;
+
+	/*
+		Size of string representation (in chars) of one Flight instance
+	*/
+	static const int STRING_REPRESENTATION_SIZE = FN_SIZE + 2 + GN_SIZE + 2 + DATE_SIZE + 2 + DEST_SIZE + 2 + 3 + 2;
+
+	/*
+		Character classes (CharClass mask) which are allowed in destination. By default UTF-8 names are
+		accepted, CharClass::TEXT allows only ASCII. It should be changed only when nothing is being loaded.
+	*/
+	static unsigned char destinationClasses;
+
 private:
 	/*
-		Pointer to char array with string representation of current instance.
-		Allocation handled internally inside class.
+		Char array with string representation of current instance.
+		Filled once when instance is read (Flight::render()).
 	*/
-	char* stringRepresentation;
+	char stringRepresentation[STRING_REPRESENTATION_SIZE];
 
 	/* Flag describing if instance is loaded (if data is not empty) */
 	bool flightLoaded;
 
-public:
-	std::string destination;
-	std::string flightTime;
-	std::string flightNumber;
-	std::string gateNumber;
+	/*
+		Function which fills stringRepresentation array from instance data.
+	*/
+	void render();
 
+public:
 	/*
-		Constructor
+		All properties are stored inline (fixed width, null terminated), so Flight is trivially
+		copyable and arrays of Flight objects are one contiguous block of memory.
+
+		Destination is cut to DEST_SIZE characters (string representation shows no more than that).
 	*/
-	Flight();
+	char destination[DEST_SIZE + 1];
+	char flightTime[DATE_SIZE + 1];
+	char flightNumber[FN_SIZE + 1];
+	char gateNumber[GN_SIZE + 1];
 
-	/* 
-		Copy constructor. (deep copy)
+	/*
+		Flight time packed into one integer (minutes since 01.01.1970. 00:00), filled once
+		while reading so that date comparisons don't have to parse flightTime string again.
 	*/
-	Flight(Flight&);
+	int timeKey;
 
 	/*
-		Destructor.
+		Constructor
 	*/
-	~Flight();
+	Flight();
 
 	/*
 		Function that reads stream and gets Destination information (returns as a std::string)
@@ -54,9 +84,16 @@ public:
 
 	/*
 		Function that reads stream and gets Date information (returns as a std::string)
+		and stores packed time key into second parameter.
 		if anything goes wrong while reading it throws std::exception.
 	*/
-	static std::string readDate(std::istream&);
+	static std::string readDate(std::istream&, int&);
+
+	/*
+		Function which packs date and time into one integer (minutes since 01.01.1970. 00:00),
+		so that comparing two keys gives same order as comparing dates.
+	*/
+	static int toTimeKey(int, int, int, int, int);
 
 	/*
 		Function that reads stream and gets Flight number information (returns as a std::string)
@@ -70,41 +107,30 @@ public:
 	*/
 	static std::string readGateNumber(std::istream&);
 
-public:
-	/*
-		Constant which limits maximum number of characters in each string property
-	*/
-	static const int MAX_STRING_SIZE = 100;
-
-	/*
-		Constants defining how many character size is for which string
-	*/
-	static const int FN_SIZE = 5, GN_SIZE = 2, DATE_SIZE = 17, DEST_SIZE = 20;
-
-	/*
-		Size of string representation (in chars) of one Flight instance
-	*/
-	static const int STRING_REPRESENTATION_SIZE = FN_SIZE + 2 + GN_SIZE + 2 + DATE_SIZE + 2 + DEST_SIZE + 2 + 3 + 2;
-
 	/*
 		Getter method for destination property 
 	*/
-	std::string getDestination() const;
+	const char* getDestination() const;
 
 	/*
 		Getter method for flight time property 
 	*/
-	std::string getFlightTime() const;
+	const char* getFlightTime() const;
 
 	/*
 		Getter method for flight number property 
 	*/
-	std::string getFlightNumber() const;
+	const char* getFlightNumber() const;
 
 	/* 
 		Getter method for gate number property
 	*/
-	std::string getGateNumber() const;
+	const char* getGateNumber() const;
+
+	/*
+		Getter method for packed flight time key
+	*/
+	int getTimeKey() const;
 
 	/*
 		Function which return's pointer to string representation of Flight instance.
@@ -117,6 +143,35 @@ public:
 		Overloaded operator for reading object from some input stream.
 	*/
 	friend std::istream& operator>>(std::istream&, Flight&);
+
+	/*
+		Enumeration of results of Flight::tryParse() (which field of row is not valid).
+	*/
+	enum { PARSE_OK = 0, BAD_DESTINATION, BAD_DATE, DATE_OUT_OF_RANGE, BAD_FLIGHT_NUMBER, BAD_GATE_NUMBER };
+
+	/*
+		Function which reads one Flight (one row) directly from char buffer (e.g. memory mapped file),
+		same format as operator>>, without any allocation or stream calls.
+		Returns pointer to begining of next row, if anything goes wrong it throws std::exception.
+	*/
+	static const char* parse(const char *, const char *, Flight&);
+
+	/*
+		Non throwing version of Flight::parse(), returns status (enumeration) and stores begining of
+		next row in last parameter (even if row is not valid, so reading can continue).
+	*/
+	static int tryParse(const char *, const char *, Flight&, const char **);
+
+	/*
+		Function which returns description of Flight::tryParse() status.
+	*/
+	static const char* statusMessage(int);
+
+	/*
+		Function which fills instance from properties which are already valid (e.g. read from binary file),
+		without any checking, and marks instance as loaded.
+	*/
+	void set(const char *, const char *, int, const char *, const char *);
 };
 
 #endif
\ No newline at end of file
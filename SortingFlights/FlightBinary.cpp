@@ -0,0 +1,215 @@
+#include "FlightBinary.h"
+
+#include <fstream>
+
+/*
+	Local function which rounds size up to 8 byte boundary.
+
+	@param size -> (size_t) size in bytes.
+
+	@return (size_t) rounded size.
+*/
+inline size_t align(size_t size)
+{
+	return (size + 7) & ~(size_t) 7;
+}
+
+/*
+	Local structure with offsets (from begining of file) of all blocks, calculated from header.
+*/
+struct Layout
+{
+	size_t flightNumberCodes, timeKeys, destinationIds, gateCodes, flightTimes, dictionary, total;
+
+	Layout(size_t rows, size_t destinations)
+	{
+		flightNumberCodes = align(sizeof(FlightBinary::Header));
+		timeKeys = align(flightNumberCodes + rows * sizeof(long long));
+		destinationIds = align(timeKeys + rows * sizeof(int));
+		gateCodes = align(destinationIds + rows * sizeof(int));
+		flightTimes = align(gateCodes + rows * sizeof(int));
+		dictionary = align(flightTimes + rows * Flight::DATE_SIZE);
+		total = dictionary + destinations * (Flight::DEST_SIZE + 1);
+	}
+};
+
+/*
+	Local function which writes block of bytes into stream, padded with zeros to given offset.
+
+	@param ofs -> (std::ofstream&) stream.
+	@param offset -> (size_t) offset at which block must start (stream is padded up to it).
+	@param data -> (const void *) block.
+	@param size -> (size_t) size of block in bytes.
+
+	@throws std::exception -> if writing fails.
+*/
+void writeBlock(std::ofstream& ofs, size_t offset, const void* data, size_t size)
+{
+	static const char zeros[8] = { 0 };
+	size_t position = (size_t) ofs.tellp();
+	if (position < offset)
+		ofs.write(zeros, offset - position);
+	if (size > 0)
+		ofs.write((const char *) data, size);
+	if (ofs.fail())
+		throw std::exception("Failed writing into file.");
+}
+
+/*
+	Local function which copies column block out of buffer into vector.
+
+	@param data -> (const char *) begining of buffer.
+	@param offset -> (size_t) offset of block.
+	@param rows -> (size_t) number of elements in block.
+	@param column -> (std::vector<Type>&) vector which is filled.
+*/
+template <typename Type>
+void readBlock(const char* data, size_t offset, size_t rows, std::vector<Type>& column)
+{
+	column.resize(rows);
+	if (rows > 0)
+		memcpy(&column[0], data + offset, rows * sizeof(Type));
+}
+
+/*
+	Function which checks if buffer begins with binary file magic.
+
+	@param data -> (const char *) begining of buffer.
+	@param size -> (size_t) size of buffer.
+
+	@return (bool) true if buffer is (or at least claims to be) binary file.
+*/
+bool FlightBinary::isBinary(const char* data, size_t size)
+{
+	return size >= sizeof(MAGIC) && memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+/*
+	Function which writes Flight objects and their columns into binary file.
+
+	Columns are written as they are (destination ids stay valid because dictionary is written whole),
+	only permuted by indexes, so writing is few big writes, one per block.
+
+	@param path -> (const char *) path to file.
+	@param flights -> (const Flight *) array of Flight objects (columns must be built from it).
+	@param columns -> (const FlightColumns&) columns of Flight objects.
+	@param indexes -> (const int *) (has default) order in which Flight objects are written.
+
+	@throws std::exception -> if file can not be written.
+*/
+void FlightBinary::write(const char* path, const Flight* flights, const FlightColumns& columns, const int* indexes)
+{
+	size_t rows = columns.size(), destinations = columns.destinations.size();
+	Layout layout(rows, destinations);
+
+	Header header;
+	memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.headerSize = sizeof(Header);
+	header.rows = (unsigned) rows;
+	header.destinations = (unsigned) destinations;
+	header.destinationSize = Flight::DEST_SIZE;
+	header.dateSize = Flight::DATE_SIZE;
+	header.reserved = 0;
+
+	std::vector<long long> flightNumberCodes(rows);
+	std::vector<int> timeKeys(rows), destinationIds(rows), gateCodes(rows);
+	std::vector<char> flightTimes(rows * Flight::DATE_SIZE);
+	std::vector<char> dictionary(destinations * (Flight::DEST_SIZE + 1), '\0');
+
+	for (size_t i = 0; i < rows; i++)
+	{
+		size_t j = (indexes != nullptr ? indexes[i] : i);
+		flightNumberCodes[i] = columns.flightNumberCodes[j];
+		timeKeys[i] = columns.timeKeys[j];
+		destinationIds[i] = columns.destinationIds[j];
+		gateCodes[i] = columns.gateCodes[j];
+		memcpy(&flightTimes[i * Flight::DATE_SIZE], flights[j].getFlightTime(), Flight::DATE_SIZE);
+	}
+
+	for (size_t i = 0; i < destinations; i++)
+		memcpy(&dictionary[i * (Flight::DEST_SIZE + 1)], columns.destinations[i].c_str(), columns.destinations[i].length());
+
+	std::ofstream ofs(path, std::ios::binary);
+	if (!ofs)
+		throw std::exception("Can not write into file.");
+
+	writeBlock(ofs, 0, &header, sizeof(Header));
+	writeBlock(ofs, layout.flightNumberCodes, rows > 0 ? &flightNumberCodes[0] : nullptr, rows * sizeof(long long));
+	writeBlock(ofs, layout.timeKeys, rows > 0 ? &timeKeys[0] : nullptr, rows * sizeof(int));
+	writeBlock(ofs, layout.destinationIds, rows > 0 ? &destinationIds[0] : nullptr, rows * sizeof(int));
+	writeBlock(ofs, layout.gateCodes, rows > 0 ? &gateCodes[0] : nullptr, rows * sizeof(int));
+	writeBlock(ofs, layout.flightTimes, rows > 0 ? &flightTimes[0] : nullptr, flightTimes.size());
+	writeBlock(ofs, layout.dictionary, destinations > 0 ? &dictionary[0] : nullptr, dictionary.size());
+
+	ofs.close();
+}
+
+/*
+	Function which reads binary file from buffer into Flight objects and columns.
+
+	Header is checked (magic, version and field sizes must match this build, and buffer must be big
+	enough for all blocks), then column blocks are copied into columns as they are, and Flight objects
+	are filled from columns (Flight::set), so nothing is parsed.
+
+	@param data -> (const char *) begining of buffer.
+	@param size -> (size_t) size of buffer.
+	@param flights -> (std::vector<Flight>&) vector which is filled with Flight objects (old content is removed).
+	@param columns -> (FlightColumns&) columns which are filled (old content is removed).
+
+	@throws std::exception -> if buffer is not valid binary file.
+*/
+void FlightBinary::read(const char* data, size_t size, std::vector<Flight>& flights, FlightColumns& columns)
+{
+	Header header;
+	if (size < sizeof(Header))
+		throw std::exception("Bad binary file!");
+	memcpy(&header, data, sizeof(Header));
+
+	if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || header.headerSize != sizeof(Header) ||
+		header.destinationSize != Flight::DEST_SIZE || header.dateSize != Flight::DATE_SIZE)
+		throw std::exception("Unsupported binary file!");
+
+	// counts are checked against size first, so that layout calculation can't overflow
+	size_t rows = header.rows, destinations = header.destinations;
+	if (rows > size / (sizeof(long long) + 3 * sizeof(int) + Flight::DATE_SIZE) || destinations > size / (Flight::DEST_SIZE + 1))
+		throw std::exception("Bad binary file!");
+
+	Layout layout(rows, destinations);
+	if (layout.total > size)
+		throw std::exception("Bad binary file!");
+
+	columns.clear();
+	readBlock(data, layout.flightNumberCodes, rows, columns.flightNumberCodes);
+	readBlock(data, layout.timeKeys, rows, columns.timeKeys);
+	readBlock(data, layout.destinationIds, rows, columns.destinationIds);
+	readBlock(data, layout.gateCodes, rows, columns.gateCodes);
+
+	columns.destinations.reserve(destinations);
+	for (size_t i = 0; i < destinations; i++)
+	{
+		const char* destination = data + layout.dictionary + i * (Flight::DEST_SIZE + 1);
+		columns.destinations.push_back(std::string(destination, strnlen(destination, Flight::DEST_SIZE)));
+	}
+
+	char flightNumber[Flight::FN_SIZE], gateNumber[Flight::GN_SIZE];
+	const char* flightTimes = data + layout.flightTimes;
+
+	flights.clear();
+	flights.resize(rows);
+	for (size_t i = 0; i < rows; i++)
+	{
+		int id = columns.destinationIds[i];
+		if (id < 0 || (size_t) id >= destinations)
+		{
+			flights.clear();
+			columns.clear();
+			throw std::exception("Bad binary file!");
+		}
+
+		FlightColumns::decodeFlightNumber(columns.flightNumberCodes[i], flightNumber);
+		FlightColumns::decodeGateNumber(columns.gateCodes[i], gateNumber);
+		flights[i].set(columns.destinations[id].c_str(), flightTimes + i * Flight::DATE_SIZE, columns.timeKeys[i],
+						flightNumber, gateNumber);
+	}
+}
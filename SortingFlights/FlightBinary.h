@@ -0,0 +1,68 @@
+#ifndef _FLIGHT_BINARY_INCLUDED_
+#define _FLIGHT_BINARY_INCLUDED_
+
+#include <vector>
+#include <cstddef>
+
+#include "Flight.h"
+#include "FlightColumns.h"
+
+/*
+	Namespace designed for native binary flight file format (.sfb).
+
+	File is image of FlightColumns, so loading it needs no parsing, only copying of column blocks
+	out of mapped memory (MappedFile). All numbers are stored little endian, each block starts on
+	8 byte boundary (padded with zeros), and blocks follow header in this order:
+
+		Header									-> magic, version, row count, dictionary size, field sizes.
+		flightNumberCodes	(long long * rows)	-> FlightColumns::encodeFlightNumber.
+		timeKeys			(int * rows)		-> Flight::toTimeKey.
+		destinationIds		(int * rows)		-> index into destination dictionary.
+		gateCodes			(int * rows)		-> FlightColumns::encodeGateNumber.
+		flightTimes			(char[DATE_SIZE] * rows)	-> flight time text (so file is written back exactly as read).
+		dictionary			(char[DEST_SIZE + 1] * destinations)	-> alphabetical, null padded destinations.
+
+	@author Acko.
+*/
+namespace FlightBinary
+{
+	/*
+		Magic bytes at begining of file, and current version of format.
+	*/
+	const char MAGIC[4] = { 'S', 'F', 'B', '\x1A' };
+	const unsigned VERSION = 1;
+
+	/*
+		Header of binary file (32 bytes).
+	*/
+	struct Header
+	{
+		char magic[4];
+		unsigned version;
+		unsigned headerSize;
+		unsigned rows;
+		unsigned destinations;
+		unsigned destinationSize;
+		unsigned dateSize;
+		unsigned reserved;
+	};
+
+	/*
+		Function which checks if buffer begins with binary file magic (so it is not text file).
+	*/
+	bool isBinary(const char *, size_t);
+
+	/*
+		Function which writes Flight objects and their columns into binary file, in order given by
+		indexes (if passed). If anything goes wrong, it throws std::exception.
+	*/
+	void write(const char *, const Flight *, const FlightColumns&, const int * = nullptr);
+
+	/*
+		Function which reads binary file from buffer (e.g. memory mapped file) into Flight objects
+		and columns. If buffer is not valid binary file, it throws std::exception.
+	*/
+	void read(const char *, size_t, std::vector<Flight>&, FlightColumns&);
+};
+
+#endif
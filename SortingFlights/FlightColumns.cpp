@@ -0,0 +1,170 @@
+#include "FlightColumns.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "Sorter.h"
+
+/*
+	Function which fills all columns from array of Flight objects.
+
+	Distinct destinations are first collected in hash table (each one gets number in order of first
+	appearance), then they are sorted (Sorter::multikeySort, which doesn't compare common prefixes of
+	names again and again), and position of each one in sorted order becomes its id. So comparing ids
+	is same as comparing destinations.
+
+	@param flights -> (const Flight *) array of Flight objects.
+	@param size -> (int) number of Flight objects in array.
+*/
+void FlightColumns::build(const Flight* flights, int size)
+{
+	clear();
+
+	destinationIds.resize(size);
+	timeKeys.resize(size);
+	flightNumberCodes.resize(size);
+	gateCodes.resize(size);
+
+	std::unordered_map<std::string, int> found;
+	std::vector<const char*> names;
+	for (int i = 0; i < size; i++)
+	{
+		std::pair<std::unordered_map<std::string, int>::iterator, bool> added =
+			found.insert(std::make_pair(std::string(flights[i].getDestination()), (int) names.size()));
+		if (added.second)
+			names.push_back(flights[i].getDestination());
+		destinationIds[i] = added.first -> second;
+	}
+
+	std::vector<int> order(names.size()), ids(names.size());
+	Sorter::multikeySort(names.data(), names.size(), order.data());
+
+	destinations.reserve(names.size());
+	for (size_t i = 0; i < names.size(); i++)
+	{
+		ids[order[i]] = (int) i;
+		destinations.push_back(names[order[i]]);
+	}
+
+	for (int i = 0; i < size; i++)
+	{
+		destinationIds[i] = ids[destinationIds[i]];
+		timeKeys[i] = flights[i].getTimeKey();
+		flightNumberCodes[i] = encodeFlightNumber(flights[i].getFlightNumber());
+		gateCodes[i] = encodeGateNumber(flights[i].getGateNumber());
+	}
+}
+
+/*
+	Function which adds rows appended to array of Flight objects since columns were built (or last appended),
+	so only new rows are encoded.
+
+	If all new destinations are already in dictionary (it is searched with binary search), ids of old rows
+	stay valid and only new rows are added. Otherwise ids of all rows would change, so columns are rebuilt.
+
+	@param flights -> (const Flight *) array of Flight objects (same one from which columns were built).
+	@param size -> (int) number of Flight objects in array now (not smaller than FlightColumns::size()).
+*/
+void FlightColumns::append(const Flight* flights, int size)
+{
+	int oldSize = this -> size();
+
+	std::vector<int> ids(size - oldSize);
+	for (int i = oldSize; i < size; i++)
+	{
+		std::vector<std::string>::const_iterator found =
+			std::lower_bound(destinations.begin(), destinations.end(), std::string(flights[i].getDestination()));
+		if (found == destinations.end() || *found != flights[i].getDestination())
+		{
+			build(flights, size);
+			return;
+		}
+		ids[i - oldSize] = (int) (found - destinations.begin());
+	}
+
+	destinationIds.insert(destinationIds.end(), ids.begin(), ids.end());
+	for (int i = oldSize; i < size; i++)
+	{
+		timeKeys.push_back(flights[i].getTimeKey());
+		flightNumberCodes.push_back(encodeFlightNumber(flights[i].getFlightNumber()));
+		gateCodes.push_back(encodeGateNumber(flights[i].getGateNumber()));
+	}
+}
+
+/*
+	Function which empties all columns and dictionary.
+*/
+void FlightColumns::clear()
+{
+	destinations.clear();
+	destinationIds.clear();
+	timeKeys.clear();
+	flightNumberCodes.clear();
+	gateCodes.clear();
+}
+
+/*
+	Function which returns number of rows stored in columns.
+
+	@returns (int) number of rows.
+*/
+int FlightColumns::size() const
+{
+	return (int) timeKeys.size();
+}
+
+/*
+	Function which encodes flight number into one integer, one byte per character, first character
+	in highest byte, so integer order is same as alphabetical order.
+
+	@param flightNumber -> (const char *) flight number (Flight::FN_SIZE characters).
+
+	@returns (long long) encoded flight number.
+*/
+long long FlightColumns::encodeFlightNumber(const char* flightNumber)
+{
+	long long code = 0;
+	for (int i = 0; i < Flight::FN_SIZE; i++)
+		code = (code << 8) | (unsigned char) flightNumber[i];
+	return code;
+}
+
+/*
+	Function which encodes gate number into one integer, one byte per character, first character
+	in highest byte, so integer order is same as alphabetical order.
+
+	@param gateNumber -> (const char *) gate number (Flight::GN_SIZE characters).
+
+	@returns (int) encoded gate number.
+*/
+int FlightColumns::encodeGateNumber(const char* gateNumber)
+{
+	int code = 0;
+	for (int i = 0; i < Flight::GN_SIZE; i++)
+		code = (code << 8) | (unsigned char) gateNumber[i];
+	return code;
+}
+
+/*
+	Function which decodes flight number, reverse of FlightColumns::encodeFlightNumber.
+
+	@param code -> (long long) encoded flight number.
+	@param flightNumber -> (char *) array into which Flight::FN_SIZE characters are written (not null terminated).
+*/
+void FlightColumns::decodeFlightNumber(long long code, char* flightNumber)
+{
+	for (int i = Flight::FN_SIZE - 1; i >= 0; i--, code >>= 8)
+		flightNumber[i] = (char) (code & 0xFF);
+}
+
+/*
+	Function which decodes gate number, reverse of FlightColumns::encodeGateNumber.
+
+	@param code -> (int) encoded gate number.
+	@param gateNumber -> (char *) array into which Flight::GN_SIZE characters are written (not null terminated).
+*/
+void FlightColumns::decodeGateNumber(int code, char* gateNumber)
+{
+	for (int i = Flight::GN_SIZE - 1; i >= 0; i--, code >>= 8)
+		gateNumber[i] = (char) (code & 0xFF);
+}
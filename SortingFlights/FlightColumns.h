@@ -0,0 +1,84 @@
+#ifndef _FLIGHT_COLUMNS_INCLUDED_
+#define _FLIGHT_COLUMNS_INCLUDED_
+
+#include <string>
+#include <vector>
+
+#include "Flight.h"
+
+/*
+	Class FlightColumns, column (struct of arrays) view of Flight data.
+
+	Each Flight property is encoded as an integer key and stored in its own contiguous array,
+	so sorting or scanning by one property touches only memory of that property.
+	Keys are encoded so that comparing two keys gives same order as comparing original strings:
+
+		destinationIds		-> index of destination inside alphabetically ordered dictionary.
+		timeKeys			-> Flight::timeKey (minutes since 01.01.1970. 00:00).
+		flightNumberCodes	-> flight number characters packed into one integer (first char highest).
+		gateCodes			-> gate number characters packed into one integer (first char highest).
+
+	@author Acko.
+*/
+class FlightColumns
+{
+public:
+	/*
+		Dictionary of all distinct destinations in alphabetical order (destinationIds index it).
+	*/
+	std::vector<std::string> destinations;
+
+	/* Column of destination ids */
+	std::vector<int> destinationIds;
+
+	/* Column of packed flight times */
+	std::vector<int> timeKeys;
+
+	/* Column of encoded flight numbers */
+	std::vector<long long> flightNumberCodes;
+
+	/* Column of encoded gate numbers */
+	std::vector<int> gateCodes;
+
+	/*
+		Function which fills all columns from array of Flight objects.
+	*/
+	void build(const Flight*, int);
+
+	/*
+		Function which adds rows appended to array of Flight objects since columns were built.
+	*/
+	void append(const Flight*, int);
+
+	/*
+		Function which empties all columns and dictionary.
+	*/
+	void clear();
+
+	/*
+		Function which returns number of rows stored in columns.
+	*/
+	int size() const;
+
+	/*
+		Function which encodes flight number (Flight::FN_SIZE characters) into one integer.
+	*/
+	static long long encodeFlightNumber(const char *);
+
+	/*
+		Function which encodes gate number (Flight::GN_SIZE characters) into one integer.
+	*/
+	static int encodeGateNumber(const char *);
+
+	/*
+		Function which decodes flight number from integer into char array (Flight::FN_SIZE characters, not null terminated).
+	*/
+	static void decodeFlightNumber(long long, char *);
+
+	/*
+		Function which decodes gate number from integer into char array (Flight::GN_SIZE characters, not null terminated).
+	*/
+	static void decodeGateNumber(int, char *);
+};
+
+#endif
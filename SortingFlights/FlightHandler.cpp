@@ -1,98 +1,348 @@
 #include "FlightHandler.h"
 
+#include <sys/stat.h>
+
 /*
-	Constructor,
+	Local function which reads size and last modification time of file.
 
-	Sets fligtsToLoad to value accepted as parameter, and isLoaded flag to false.
-	Also it allocates memory for Flight* array on heap, and memory for flightString array.
+	@param path -> (const char *) path to file.
+	@param size -> (long long&) size of file in bytes.
+	@param time -> (long long&) time of last modification.
 
-	@param flightsToLoad -> (int) number of Flight object to load and store.
+	@return (bool) true if file exists, false otherwise.
 */
-FlightHandler::FlightHandler(int flightsToLoad)
-	:  flightsToLoad(flightsToLoad), isLoaded(false)
+bool fileState(const char* path, long long& size, long long& time)
 {
-	flights = new Flight*[flightsToLoad];
-	for (int i = 0; i < flightsToLoad; i++)
-		flights[i] = nullptr;
-
-	flightsString = new const char*[flightsToLoad];
+#ifdef _WIN32
+	struct _stat64 info;
+	if (_stat64(path, &info) != 0)
+		return false;
+#else
+	struct stat info;
+	if (stat(path, &info) != 0)
+		return false;
+#endif
+	size = (long long) info.st_size;
+	time = (long long) info.st_mtime;
+	return true;
 }
 
 /*
-	Destructor,
+	Constructor,
+
+	Sets isLoaded flag to false. Memory for Flight objects is allocated while loading.
+*/
+FlightHandler::FlightHandler()
+	: isLoaded(false), sourceBytes(0), sourceTime(0), sourceAppendable(false)
+{
+}
 
-	Cleans up after FlightHandler constructor, it deallocates heap memory reserved for
-	Flight* array and FligthsString char array. Also it deallocates memory reserved for each
-	Flight instance which is created by this instance in loadData().
+/*
+	Destructor, Empty (vectors clean up after themselves).
 */
 FlightHandler::~FlightHandler()
 {
-	clearFlights();
-	delete[] flights;
-	delete[] flightsString;
 }
 
 /*
 	Function which takes path to database file as a parameter, and tries to read that file.
 
-	It reads from file appropriate number of Flight objects (which creates on Heap), and store they're
-	pointers into FlightHandler::Flights** array.
+	File is memory mapped (MappedFile) and Flight objects are parsed straight out of mapped memory
+	(Flight::parse) into FlightHandler::flights vector, so no stream calls or allocation is done per field.
+	Big files are parsed on multiple threads (FlightParser).
+	If file is binary (FlightBinary), Flight objects and columns are copied from it without parsing.
+	If file is gzip compressed, it is inflated on separate thread and parsed while it is inflated
+	(FlightPipeline::loadGzip), without temporary file.
 	If anything goes wrong while reading, it throws std::exception.
+	If report is supplied rows which are not valid don't stop loading, they are skipped and their line,
+	byte offset and reason are recorded in report (all valid rows are kept).
+
+	@param databasePath -> (const char *) path to database file.
+	@param report -> (FlightParser::ParseReport *) (has default) report for non throwing mode, nullptr means throwing mode.
+
+	@throws std::exception -> if anything goes wrong while reading (only file errors if report is supplied).
+*/
+void FlightHandler::loadFlights(const char* databasePath, FlightParser::ParseReport* report)
+{
+	if (!*databasePath)
+		throw std::exception("Database path not suplied! Program will load default io path.");
+
+	bool binary = false, compressed = false;
+	size_t bytes = 0;
+	try
+	{
+		{
+			MappedFile file(databasePath);
+			bytes = file.size();
+			binary = FlightBinary::isBinary(file.data(), file.size());
+			compressed = FlightPipeline::isGzip(file.data(), file.size());
+			if (binary)
+			{
+				FlightBinary::read(file.data(), file.size(), flights, columns);
+				if (report != nullptr)
+					report -> rows += flights.size();
+			}
+			else if (!compressed)
+				parseFlights(file.data(), file.data() + file.size(), report);
+		}
+
+		// compressed file is inflated on its own thread and streamed into parser
+		if (compressed)
+		{
+			flights.clear();
+			FlightPipeline::loadGzip(databasePath, flights, report);
+		}
+	}
+	catch (const std::exception& e)
+	{
+		clearFlights();
+		isLoaded = false;
+		throw e;
+	}
+	finishLoading(!binary);
+	rememberSource(databasePath, bytes, !binary && !compressed);
+}
+
+/*
+	Function which takes path to text database file as a parameter, and reads it through FlightPipeline.
 
-	For reading Flight objects it uses Flight::operator>>.
+	File is not mapped, reader thread reads it block by block while this thread parses blocks which are
+	already read, and only FlightPipeline::BLOCK_COUNT blocks exist, so memory used for reading is fixed
+	(only FlightHandler::flights grows with file). Binary files are not supported here (use loadFlights).
 
 	@param databasePath -> (const char *) path to database file.
+	@param report -> (FlightParser::ParseReport *) (has default) report for non throwing mode, nullptr means throwing mode.
 
-	@throws std::exception -> if anything goes wrong while reading.
+	@throws std::exception -> if anything goes wrong while reading (only file errors if report is supplied).
 */
-void FlightHandler::loadFlights(const char* databasePath)
+void FlightHandler::streamFlights(const char* databasePath, FlightParser::ParseReport* report)
 {
 	if (!*databasePath)
 		throw std::exception("Database path not suplied! Program will load default io path.");
 
-	// open file stream and read n flights
-	std::ifstream ifs(databasePath);
+	size_t bytes = 0;
 	try
-	{	
-		if (!ifs)
-			throw std::exception("Invalid path! Program will load default io path.");
+	{
+		flights.clear();
+		bytes = FlightPipeline::load(databasePath, flights, report);
+	}
+	catch (const std::exception& e)
+	{
+		clearFlights();
+		isLoaded = false;
+		throw e;
+	}
+	finishLoading();
+	rememberSource(databasePath, bytes, true);
+}
+
+/*
+	Function which parses only rows appended to file since it was loaded (or last appended).
+
+	File from which flights were loaded is checked first: if it is smaller than number of bytes already
+	parsed, if its size is same but it was modified, or if last parsed bytes are not same any more, it was
+	not only appended to, so it is loaded again whole (loadFlights). Same is done if it was not plain text.
+	Otherwise file is mapped, and only complete rows (ending with new line) after last parsed byte are parsed
+	and added after loaded Flight objects (row which is still being written is left for next call).
+	Columns are extended (FlightColumns::append), so loaded flights are not touched.
+
+	If report is supplied, lines in it are counted from first appended row, and offsets are offsets in file.
+
+	@param report -> (FlightParser::ParseReport *) (has default) report for non throwing mode, nullptr means throwing mode.
+
+	@throws std::exception -> if flights are not loaded, file can not be read, or any new row is not valid
+								(only if report is not supplied; then loaded flights stay as they were).
+
+	@return (int) number of added Flight objects, or RELOADED if file was loaded again whole.
+*/
+int FlightHandler::appendFlights(FlightParser::ParseReport* report)
+{
+	if (!isLoaded || sourcePath.empty())
+		throw std::exception("Flights are not loaded.");
+
+	std::string path = sourcePath;
+	long long fileSize, fileTime;
+	if (!fileState(path.c_str(), fileSize, fileTime))
+		throw std::exception("Can not open file.");
+
+	// last loaded row without new line may still be written, so it can't be continued
+	bool reload = !sourceAppendable || fileSize < (long long) sourceBytes ||
+		(fileSize == (long long) sourceBytes && fileTime != sourceTime) ||
+		(!sourceTail.empty() && sourceTail[sourceTail.size() - 1] != '\n');
+
+	if (!reload && fileSize == (long long) sourceBytes)
+		return 0;
 
-		Flight* tempFlight;
-		for (int i = 0; i < this -> flightsToLoad; i++)
+	int oldSize = size();
+	size_t parsed = sourceBytes;
+	if (!reload)
+	{
+		MappedFile file(path.c_str());
+		reload = file.size() < sourceBytes ||
+			memcmp(file.data() + sourceBytes - sourceTail.size(), sourceTail.data(), sourceTail.size()) != 0;
+
+		if (!reload)
 		{
-			tempFlight = new Flight();
+			const char* begin = file.data() + sourceBytes;
+			const char* end = file.data() + file.size();
+			const char* last = end;
+			while (last != begin && last[-1] != '\n')
+				--last;
+
+			try
+			{
+				FlightParser::parseRows(begin, last, flights, report, sourceBytes);
+			}
+			catch (const std::exception& e)
+			{
+				flights.resize(oldSize);
+				throw e;
+			}
+			parsed = last - file.data();
+		}
+	}
+
+	if (reload)
+	{
+		loadFlights(path.c_str(), report);
+		return RELOADED;
+	}
+
+	flightsString.resize(flights.size());
+	columns.append(flights.empty() ? nullptr : &flights[0], size());
+	rememberSource(path.c_str(), parsed, true);
+
+	return size() - oldSize;
+}
+
+/*
+	Function which checks if flights are loaded from file which path is passed.
+
+	@param path -> (const char *) path to file.
+
+	@return (bool) true if flights are loaded and path is same as path they were loaded from.
+*/
+bool FlightHandler::isLoadedFrom(const char* path) const
+{
+	return isLoaded && sourcePath == path;
+}
+
+/*
+	Function which stores information about file from which flights were loaded (or appended).
+
+	Besides path and number of parsed bytes, it stores modification time and last TAIL_CHECK_SIZE parsed
+	bytes of file, so that appendFlights can check that file was only appended to.
+
+	@param path -> (const char *) path to file.
+	@param bytes -> (size_t) number of bytes of file which are parsed.
+	@param appendable -> (bool) true if file is plain text (rows can be appended to it).
+*/
+void FlightHandler::rememberSource(const char* path, size_t bytes, bool appendable)
+{
+	long long fileSize;
+	sourcePath = path;
+	sourceBytes = bytes;
+	sourceAppendable = appendable;
+	sourceTail.clear();
+	if (!fileState(path, fileSize, sourceTime))
+		sourceTime = 0;
 
-			ifs >> *tempFlight;
-			flights[i] = tempFlight;
+	if (appendable && bytes > 0)
+	{
+		size_t length = (bytes < TAIL_CHECK_SIZE ? bytes : TAIL_CHECK_SIZE);
+		std::ifstream ifs(path, std::ios::binary);
+		ifs.seekg((std::streamoff) (bytes - length));
+		sourceTail.resize(length);
+		ifs.read(&sourceTail[0], length);
+		if (!ifs)
+			sourceAppendable = false;
+	}
+}
+
+/*
+	Function which reads Flight objects from input stream until end of stream.
+
+	For reading Flight objects it uses Flight::operator>>, (vector grows as needed).
+	If anything goes wrong while reading, it throws std::exception.
+
+	@param _in -> (std::istream&) stream from which Flight objects are read.
+
+	@throws std::exception -> if anything goes wrong while reading.
+*/
+void FlightHandler::readFlights(std::istream& _in)
+{
+	try
+	{
+		flights.clear();
+		while (_in.peek() != EOF)
+		{
+			flights.push_back(Flight());
+			_in >> flights.back();
 		}
 	}
 	catch (const std::exception& e)
 	{
 		clearFlights();
-		ifs.close();
+		isLoaded = false;
 		throw e;
 	}
-	ifs.close();
+	finishLoading();
+}
+
+/*
+	Function which parses all rows from char buffer into FlightHandler::flights vector.
+
+	Parsing is done by FlightParser::parse (in parallel for big buffers).
+
+	@param begin -> (const char *) begining of buffer (can be nullptr if buffer is empty).
+	@param end -> (const char *) end of buffer.
+	@param report -> (FlightParser::ParseReport *) (has default) report for non throwing mode, nullptr means throwing mode.
+
+	@throws std::exception -> if any row is not valid (only if report is not supplied).
+*/
+void FlightHandler::parseFlights(const char* begin, const char* end, FlightParser::ParseReport* report)
+{
+	flights.clear();
+	FlightParser::parse(begin, end, flights, report);
+}
+
+/*
+	Function which is called when all Flight objects are loaded.
+
+	It sizes string array to number of loaded flights, builds columns and sets isLoaded flag.
+
+	@param buildColumns -> (bool) (has default) false if columns are already filled (binary file).
+*/
+void FlightHandler::finishLoading(bool buildColumns)
+{
+	flightsString.resize(flights.size());
+	if (buildColumns)
+		columns.build(flights.empty() ? nullptr : &flights[0], size());
 	isLoaded = true;
 }
 
 /*
 	Function which takes path to file as a parameter and tries to write current Flight objects into that file.
 
-	It open's stream and try to write all data from FlightHandler::Flights** array into that file. If second
+	It open's stream and try to write all data from FlightHandler::flights vector into that file. If second
 	parameter is passed, it does index inverting while writing (writes in specific order).
 
 	Second parameter should be pointer to an array of integers which represent order of indexes in which
 	Flight objects should be written into file. Function does not do any validation on this array, if it's
 	structure isn't right behaviour is unpredictable.
 	@example 
-		{ 0, 1, 2, 3, 4, 5, ... , flightsToLoad - 1 } -> valid, nothing changed, original structure;
-		{ 1, 2, 3, 0, 5, 4, ... , flightsToLoad - 1 } -> valid, some random permutation
+		{ 0, 1, 2, 3, 4, 5, ... , size() - 1 } -> valid, nothing changed, original structure;
+		{ 1, 2, 3, 0, 5, 4, ... , size() - 1 } -> valid, some random permutation
 		{ 0, 0, 0, 0 } -> invalid, unsuitable number of elements. (all same elements means that only 
 																	that one Flight will be written)
-		{ 0, 1, 2, flightsToLoad + n (n >= 0), ... } -> invalid, flightsToLoad + n goes out of scope
+		{ 0, 1, 2, size() + n (n >= 0), ... } -> invalid, size() + n goes out of scope
 															of original array size.
 
+	Rows are not written one by one, string representations (fixed width, Flight::STRING_REPRESENTATION_SIZE - 1
+	characters) are copied in given order into FlightHandler::writeBuffer, and each time buffer fills up it
+	is written with one call. Stream's own buffer is turned off, so each such call goes straight to file
+	and writing is limited by disk, not by stream overhead.
+
 	@param path -> (const char *) path to file in which it should write.
 	@param indexes -> (const int *) order in which Flights object should be written (described up)
 
@@ -100,27 +350,53 @@ void FlightHandler::loadFlights(const char* databasePath)
 */
 void FlightHandler::writeFlights(const char* path, const int * indexes) const
 {
-	std::ofstream ofs(path);
+	const size_t ROW_SIZE = Flight::STRING_REPRESENTATION_SIZE - 1;
 
-	try
-	{
-		if (!ofs)
-			throw std::exception("Can not write into file.");
+	std::ofstream ofs;
+	ofs.rdbuf() -> pubsetbuf(nullptr, 0);
+	ofs.open(path);
+
+	if (!ofs)
+		throw std::exception("Can not write into file.");
 
-		for (int i = 0; i < flightsToLoad; i++)
+	writeBuffer.resize(WRITE_BUFFER_SIZE);
+	char* buffer = &writeBuffer[0];
+	size_t used = 0;
+
+	for (int i = 0; i < size(); i++)
+	{
+		if (used + ROW_SIZE > WRITE_BUFFER_SIZE)
 		{
-			ofs << (indexes != nullptr ? (flights[indexes[i]] -> toString()) : flights[i] -> toString());
+			ofs.write(buffer, used);
 			if (ofs.fail())
 				throw std::exception("Failed writing into file.");
+			used = 0;
 		}
-	}
-	catch (std::exception& e)
-	{
-		ofs.close();
-		throw e;
+
+		memcpy(buffer + used, (indexes != nullptr ? flights[indexes[i]].toString() : flights[i].toString()), ROW_SIZE);
+		used += ROW_SIZE;
 	}
 
+	ofs.write(buffer, used);
 	ofs.close();
+	if (ofs.fail())
+		throw std::exception("Failed writing into file.");
+}
+
+/*
+	Function which takes path to file as a parameter and writes current Flight objects into binary file.
+
+	File is written in FlightBinary format (column blocks and destination dictionary), so it can be
+	loaded again by loadFlights without any parsing. Indexes have same meaning as in writeFlights.
+
+	@param path -> (const char *) path to the file.
+	@param indexes -> (const int *) (has default) order in which Flight objects should be written.
+
+	@throws std::exception -> if anything goes wrong while writing.
+*/
+void FlightHandler::writeBinary(const char* path, const int* indexes) const
+{
+	FlightBinary::write(path, flights.empty() ? nullptr : &flights[0], columns, indexes);
 }
 
 /*
@@ -133,6 +409,16 @@ bool FlightHandler::checkLoaded() const
 	return isLoaded;
 }
 
+/*
+	Function which returns number of loaded Flight objects.
+
+	@returns -> (int) number of Flight objects (0 if nothing is loaded).
+*/
+int FlightHandler::size() const
+{
+	return (int) flights.size();
+}
+
 /*
 	This function fills FlightHandler::flightsString array with new information. 
 
@@ -152,29 +438,32 @@ const char** FlightHandler::getFlightsString(const int* indexes) const
 	if (!isLoaded)
 		return nullptr;
 	
-	for (int i = 0; i < flightsToLoad; i++)
-		flightsString[i] = (indexes == nullptr ? flights[i] -> toString() : flights[indexes[i]] -> toString());
+	for (int i = 0; i < size(); i++)
+		flightsString[i] = (indexes == nullptr ? flights[i].toString() : flights[indexes[i]].toString());
 
-	return flightsString;
+	return flightsString.empty() ? nullptr : &flightsString[0];
 }
 
 /*
-	Function which allocates heap memory for new list in which it creates deep copy of instances in self list.
+	Function which allocates heap memory for new list of pointers to instances in self list.
+
+	Sort algorithms only switch pointers in list, so no Flight is copied, list points straight into
+	FlightHandler::flights array (which is owned by this instance, so Flight objects shouldn't be changed).
 
 	This function is only DANGEROUS function for MEMORY LEAK because it doesn't clean up after it self,
 	that is left to user. But interface for that is created (FlightHandler::destroyList(Flight **)), so
 	whenever this function is used, after should be called destroyList on same pointer.
 
-	@returns -> (Flight **) pointer to an array of copy list (with new values of instances).
+	@returns -> (Flight **) pointer to an array of pointers to instances.
 
 	@note After each call of this function it should be called FlightHandler::destroyList on pointer this function
 				returned.
 */
-Flight** FlightHandler::copyList() const
+Flight** FlightHandler::copyList()
 {
-	Flight** retList = new Flight*[flightsToLoad];
-	for (int i = 0; i < flightsToLoad; i++)
-		retList[i] = new Flight(*flights[i]);
+	Flight** retList = new Flight*[flights.size()];
+	for (int i = 0; i < size(); i++)
+		retList[i] = &flights[i];
 	return retList;
 }
 
@@ -191,25 +480,486 @@ Flight** FlightHandler::copyList() const
 */
 void FlightHandler::destroyList(Flight** list) const
 {
-	for (int i = 0; i < flightsToLoad; i++)
-		delete list[i];
 	delete[] list;
 }
 
 /*
-	Function which Handle's clearing array of Flights.
+	Function which Handle's clearing vector of Flights.
 
-	It ensures that each Flight in array first be deleted from heap. (no memory leaks).
-	If any object is deleted outside class behaviour undefined.
+	It removes all Flight objects (and their string representations and columns).
 */
 void FlightHandler::clearFlights()
 {
-	for (int i = 0; i < flightsToLoad; i++)
-		if (flights[i] != nullptr)
+	flights.clear();
+	flightsString.clear();
+	columns.clear();
+	sourcePath.clear();
+	sourceTail.clear();
+	sourceBytes = 0;
+	sourceAppendable = false;
+}
+
+/*
+	Getter method for column store of loaded Flight objects.
+
+	@returns -> (const FlightColumns&) columns of currently loaded Flight objects.
+*/
+const FlightColumns& FlightHandler::getColumns() const
+{
+	return columns;
+}
+
+/*
+	Local function which sorts one column.
+
+	It creates array of pointers into column, sorts it with Sorter::parallelSort (so only column
+	is read while sorting, on all cores), and then converts pointers back to row indexes.
+	If log is supplied it is sorted with Sorter::quickSort (see Sorter::parallelSort).
+
+	@param column -> (const Key *) column which should be sorted.
+	@param size -> (int) number of rows in column.
+	@param compare -> (Compare) compare function object for column keys (FlightHandler::KeyUp or KeyDown).
+	@param indexes -> (int *) array which will be filled with sorted order of rows.
+	@param log -> (Log *) pointer to an Log instance which is used for tracking sort moves, or nullptr.
+*/
+template <typename Key, typename Compare>
+void sortKeys(const Key* column, int size, Compare compare, int* indexes, Log* log)
+{
+	const Key** keys = new const Key*[size];
+	for (int i = 0; i < size; i++)
+		keys[i] = column + i;
+
+	Sorter::parallelSort<const Key>(keys, size, compare, log);
+
+	for (int i = 0; i < size; i++)
+		indexes[i] = (int) (keys[i] - column);
+
+	delete[] keys;
+}
+
+/*
+	Local function which finds first rows of sorted order of one column.
+
+	It creates array of pointers into column, and moves count smallest keys (by compare function object) to its
+	start in sorted order with Sorter::partialSort, so other keys are not sorted at all.
+
+	@param column -> (const Key *) column which should be searched.
+	@param size -> (int) number of rows in column.
+	@param count -> (int) number of rows which should be found (not bigger than size).
+	@param compare -> (Compare) compare function object for column keys (FlightHandler::KeyUp or KeyDown).
+	@param indexes -> (int *) array which will be filled with first count rows of sorted order.
+*/
+template <typename Key, typename Compare>
+void selectKeys(const Key* column, int size, int count, Compare compare, int* indexes)
+{
+	std::vector<const Key*> keys(size);
+	for (int i = 0; i < size; i++)
+		keys[i] = column + i;
+
+	Sorter::partialSort<const Key>(&keys[0], size, count, compare);
+
+	for (int i = 0; i < count; i++)
+		indexes[i] = (int) (keys[i] - column);
+}
+
+/*
+	Local function which sorts rows which are added after first ones, and merges them into sorted order of first rows.
+
+	New rows are sorted on their own (sortKeys), and then both sorted runs are merged from back of array
+	(so no extra array is needed for merging). If keys are equal old row goes first, so new rows keep
+	their place after all rows with same key.
+
+	@param column -> (const Key *) column of all rows.
+	@param oldSize -> (int) number of rows already in sorted order (first oldSize elements of indexes).
+	@param size -> (int) number of all rows.
+	@param compare -> (Compare) compare function object for column keys (FlightHandler::KeyUp or KeyDown).
+	@param indexes -> (int *) array (with place for all rows), first oldSize elements are sorted order of first rows.
+*/
+template <typename Key, typename Compare>
+void mergeKeys(const Key* column, int oldSize, int size, Compare compare, int* indexes)
+{
+	int count = size - oldSize;
+	std::vector<int> added(count);
+	sortKeys(column + oldSize, count, compare, &added[0], (Log *) nullptr);
+
+	int i = oldSize - 1, j = count - 1, k = size - 1;
+	while (j >= 0)
+	{
+		if (i >= 0 && compare(column[oldSize + added[j]], column[indexes[i]]))
+			indexes[k--] = indexes[i--];
+		else
+			indexes[k--] = oldSize + added[j--];
+	}
+}
+
+/*
+	Local functions which map column key to unsigned key for Sorter::radixSort. Sign bit is flipped, so unsigned
+	keys are in same order as signed ones, and all bits are inverted for descending order.
+
+	@param key -> (int / long long) column key.
+	@param descending -> (bool) true if keys should be sorted in descending order.
+
+	@returns (unsigned / unsigned long long) radix key.
+*/
+inline unsigned radixKey(int key, bool descending)
+{
+	unsigned code = (unsigned) key ^ 0x80000000u;
+	return descending ? ~code : code;
+}
+
+inline unsigned long long radixKey(long long key, bool descending)
+{
+	unsigned long long code = (unsigned long long) key ^ 0x8000000000000000ull;
+	return descending ? ~code : code;
+}
+
+/*
+	Local function which sorts one column with Sorter::radixSort.
+
+	@param column -> (const Key *) column which should be sorted.
+	@param size -> (int) number of rows in column.
+	@param descending -> (bool) true if column should be sorted in descending order.
+	@param indexes -> (int *) array which will be filled with sorted order of rows.
+	@param log -> (Log *) pointer to an Log instance which is used for tracking sort moves, or nullptr.
+*/
+template <typename Key>
+void radixKeys(const Key* column, int size, bool descending, int* indexes, Log* log)
+{
+	typedef decltype(radixKey(Key(), false)) Code;
+
+	std::vector<Code> codes(size);
+	for (int i = 0; i < size; i++)
+		codes[i] = radixKey(column[i], descending);
+
+	Sorter::radixSort<Code>(&codes[0], size, indexes, log);
+}
+
+/*
+	Local structures which are passed to forColumn, each one does one operation on column of sort criteria.
+*/
+struct SortColumn
+{
+	int size;
+	int* indexes;
+	Log* log;
+
+	template <typename Key, typename Compare>
+	void operator()(const Key* column, Compare compare)
+	{
+		sortKeys(column, size, compare, indexes, log);
+	}
+};
+
+struct RadixColumn
+{
+	int size;
+	int* indexes;
+	Log* log;
+
+	template <typename Key>
+	void operator()(const Key* column, FlightHandler::KeyUp)
+	{
+		radixKeys(column, size, false, indexes, log);
+	}
+
+	template <typename Key>
+	void operator()(const Key* column, FlightHandler::KeyDown)
+	{
+		radixKeys(column, size, true, indexes, log);
+	}
+};
+
+struct KeyColumn
+{
+	int size;
+	unsigned long long* keys;
+
+	template <typename Key>
+	void operator()(const Key* column, FlightHandler::KeyUp)
+	{
+		for (int i = 0; i < size; i++)
+			keys[i] = radixKey(column[i], false);
+	}
+
+	template <typename Key>
+	void operator()(const Key* column, FlightHandler::KeyDown)
+	{
+		for (int i = 0; i < size; i++)
+			keys[i] = radixKey(column[i], true);
+	}
+};
+
+struct SelectColumn
+{
+	int size, count;
+	int* indexes;
+
+	template <typename Key, typename Compare>
+	void operator()(const Key* column, Compare compare)
+	{
+		selectKeys(column, size, count, compare, indexes);
+	}
+};
+
+struct MergeColumn
+{
+	int oldSize, size;
+	int* indexes;
+
+	template <typename Key, typename Compare>
+	void operator()(const Key* column, Compare compare)
+	{
+		mergeKeys(column, oldSize, size, compare, indexes);
+	}
+};
+
+/*
+	Local function which chooses column and compare function object of sort criteria, and calls action with them.
+
+	Order is same as order given by criteria compare functions (destinationUp ... gateNumberDown).
+
+	@param columns -> (const FlightColumns&) columns (must not be empty).
+	@param criteria -> (int) sort criteria (FlightHandler enumeration).
+	@param action -> (Action&) structure which is called with column and compare function object.
+
+	@throws std::exception -> if criteria is unknown.
+*/
+template <typename Action>
+void forColumn(const FlightColumns& columns, int criteria, Action& action)
+{
+	switch (criteria)
+	{
+	case FlightHandler::DESTINATION_UP:
+		action(&columns.destinationIds[0], FlightHandler::KeyUp());
+		break;
+	case FlightHandler::DESTINATION_DOWN:
+		action(&columns.destinationIds[0], FlightHandler::KeyDown());
+		break;
+	case FlightHandler::FLIGHT_TIME_UP:
+		action(&columns.timeKeys[0], FlightHandler::KeyDown());
+		break;
+	case FlightHandler::FLIGHT_TIME_DOWN:
+		action(&columns.timeKeys[0], FlightHandler::KeyUp());
+		break;
+	case FlightHandler::FLIGHT_NUMBER_UP:
+		action(&columns.flightNumberCodes[0], FlightHandler::KeyUp());
+		break;
+	case FlightHandler::FLIGHT_NUMBER_DOWN:
+		action(&columns.flightNumberCodes[0], FlightHandler::KeyDown());
+		break;
+	case FlightHandler::GATE_NUMBER_UP:
+		action(&columns.gateCodes[0], FlightHandler::KeyUp());
+		break;
+	case FlightHandler::GATE_NUMBER_DOWN:
+		action(&columns.gateCodes[0], FlightHandler::KeyDown());
+		break;
+	default:
+		throw std::exception("Unknown sort criteria.");
+	}
+}
+
+/*
+	Function which sorts loaded Flight objects by one column (chosen by sort criteria enumeration),
+	and fills array of indexes with sorted order. Flight objects are not touched, only column
+	of sort criteria is read.
+
+	Order is same as order given by criteria compare functions (destinationUp ... gateNumberDown).
+
+	@param criteria -> (int) sort criteria (FlightHandler enumeration).
+	@param indexes -> (int *) array (with place for all loaded flights) which will be filled with sorted order,
+						same format as used in writeFlights and getFlightsString.
+	@param log -> (Log *) (has default) pointer to an Log instance which is used for tracking sort moves.
+
+	@throws std::exception -> if flights are not loaded or criteria is unknown.
+*/
+void FlightHandler::sortByColumn(int criteria, int* indexes, Log* log) const
+{
+	if (!isLoaded)
+		throw std::exception("Flights are not loaded.");
+
+	SortColumn action = { columns.size(), indexes, log };
+	if (action.size == 0)
+		return;
+
+	forColumn(columns, criteria, action);
+}
+
+/*
+	Function which sorts loaded Flight objects by one column with radix sort, and fills array of indexes with
+	sorted order. It does same as sortByColumn, but keys of column are distributed byte by byte (Sorter::radixSort)
+	instead of being compared, so it is much faster for big lists. Rows with equal keys keep their order.
+
+	@param criteria -> (int) sort criteria (FlightHandler enumeration).
+	@param indexes -> (int *) array (with place for all loaded flights) which will be filled with sorted order,
+						same format as used in writeFlights and getFlightsString.
+	@param log -> (Log *) (has default) pointer to an Log instance which is used for tracking sort passes.
+
+	@throws std::exception -> if flights are not loaded or criteria is unknown.
+*/
+void FlightHandler::radixSortByColumn(int criteria, int* indexes, Log* log) const
+{
+	if (!isLoaded)
+		throw std::exception("Flights are not loaded.");
+
+	RadixColumn action = { columns.size(), indexes, log };
+	if (action.size == 0)
+	{
+		if (log != nullptr)
+			log -> createEntry(indexes, 0, 0, 0);
+		return;
+	}
+
+	forColumn(columns, criteria, action);
+}
+
+/*
+	Function which sorts loaded Flight objects by several criteria (lexicographic order: by first criteria, rows
+	with equal first one by second criteria, and so on), and fills array of indexes with sorted order.
+
+	Compare functions are not used at all. Keys of each criteria are made unsigned (as in radixSortByColumn),
+	minimal key is subtracted, and keys of all criteria are packed into one 64 bit key per row (first criteria
+	in highest bits), using only as many bits as range of keys needs. So whole compound order is one radix sort.
+	If keys don't fit into 64 bits, they are packed into several words, and rows are sorted by each word (from
+	least significant one) with stable radix sort, keeping order of previous passes for equal words.
+
+	@param criteria -> (const std::vector<int>&) sort criteria (FlightHandler enumeration), most important first.
+	@param indexes -> (int *) array (with place for all loaded flights) which will be filled with sorted order,
+						same format as used in writeFlights and getFlightsString.
+	@param log -> (Log *) (has default) pointer to an Log instance, Entry is stored after each pass.
+
+	@throws std::exception -> if flights are not loaded, criteria list is empty or any criteria is unknown.
+*/
+void FlightHandler::sortByCriteria(const std::vector<int>& criteria, int* indexes, Log* log) const
+{
+	if (!isLoaded)
+		throw std::exception("Flights are not loaded.");
+	if (criteria.empty())
+		throw std::exception("No sort criteria.");
+
+	int size = columns.size();
+	for (int i = 0; i < size; i++)
+		indexes[i] = i;
+	if (log != nullptr)
+		log -> createEntry(indexes, 0, 0, 0);
+	if (size == 0)
+		return;
+
+	// words of packed key, first one holds last criteria in lowest bits
+	std::vector<std::vector<unsigned long long> > words;
+	std::vector<unsigned long long> keys(size);
+	int used = 64;
+	for (size_t c = criteria.size(); c-- > 0; )
+	{
+		KeyColumn action = { size, &keys[0] };
+		forColumn(columns, criteria[c], action);
+
+		unsigned long long low = keys[0], high = keys[0];
+		for (int i = 1; i < size; i++)
+		{
+			if (keys[i] < low)
+				low = keys[i];
+			if (keys[i] > high)
+				high = keys[i];
+		}
+
+		int width = 0;
+		for (unsigned long long range = high - low; range != 0; range >>= 1)
+			width++;
+		if (width == 0)
+			continue;
+
+		if (used + width > 64)
+		{
+			words.push_back(std::vector<unsigned long long>(size, 0));
+			used = 0;
+		}
+		std::vector<unsigned long long>& word = words.back();
+		for (int i = 0; i < size; i++)
+			word[i] |= (keys[i] - low) << used;
+		used += width;
+	}
+
+	std::vector<int> order(size);
+	for (size_t w = 0; w < words.size(); w++)
+	{
+		for (int i = 0; i < size; i++)
+			keys[i] = words[w][indexes[i]];
+		Sorter::radixSort<unsigned long long>(&keys[0], size, &order[0]);
+
+		int moved = 0;
+		for (int i = 0; i < size; i++)
 		{
-			delete flights[i];
-			flights[i] = nullptr;
+			int index = indexes[order[i]];
+			if (index != indexes[i])
+				moved++;
+			order[i] = index;
 		}
+		std::copy(order.begin(), order.end(), indexes);
+
+		if (log != nullptr)
+			log -> createEntry(indexes, (int) w + 1, moved, 0);
+	}
+}
+
+/*
+	Function which finds first rows of sorted order by one column (chosen by sort criteria enumeration), and fills
+	array of indexes with them (in sorted order), without sorting other rows. So it takes O(n log count) time instead
+	of O(n log n), which is what departure board needs (for example next 50 flights by time).
+
+	Order is same as order given by criteria compare functions (destinationUp ... gateNumberDown), but rows with
+	equal keys can be in any order.
+
+	@param criteria -> (int) sort criteria (FlightHandler enumeration).
+	@param count -> (int) number of rows which are needed.
+	@param indexes -> (int *) array (with place for count rows) which will be filled with first rows of sorted order,
+						same format as used in writeFlights and getFlightsString.
+
+	@returns (int) number of rows in indexes (count, or number of loaded flights if there are less of them).
+
+	@throws std::exception -> if flights are not loaded, criteria is unknown or count is negative.
+*/
+int FlightHandler::partialSortByColumn(int criteria, int count, int* indexes) const
+{
+	if (!isLoaded)
+		throw std::exception("Flights are not loaded.");
+
+	if (count < 0)
+		throw std::exception("Bad number of flights.");
+
+	SelectColumn action = { columns.size(), std::min(count, columns.size()), indexes };
+	if (action.count == 0)
+		return 0;
+
+	forColumn(columns, criteria, action);
+	return action.count;
+}
+
+/*
+	Function which adds rows appended since sorted order of first rows was made into that order.
+
+	It is meant to be used after appendFlights: indexes array which was filled by sortByColumn (for oldSize
+	rows) is extended to all rows, without sorting old rows again. Only new rows are sorted, and then merged
+	in (so it takes linear time in number of old rows).
+
+	@param criteria -> (int) sort criteria (FlightHandler enumeration), same one used for old order.
+	@param indexes -> (int *) array (with place for all loaded flights), first oldSize elements are sorted order.
+	@param oldSize -> (int) number of rows in sorted order (size() before appendFlights).
+
+	@throws std::exception -> if flights are not loaded, criteria is unknown or oldSize is not valid.
+*/
+void FlightHandler::insertSorted(int criteria, int* indexes, int oldSize) const
+{
+	if (!isLoaded)
+		throw std::exception("Flights are not loaded.");
+
+	if (oldSize < 0 || oldSize > columns.size())
+		throw std::exception("Bad number of sorted flights.");
+
+	MergeColumn action = { oldSize, columns.size(), indexes };
+	if (oldSize == action.size)
+		return;
+
+	forColumn(columns, criteria, action);
 }
 
 //--------------------------------------------------------------------
@@ -224,99 +974,49 @@ void FlightHandler::clearFlights()
 /* Criteria: By destination in Alphabetical order */
 bool FlightHandler::destinationUp(const Flight& f1, const Flight& f2)
 {
-	return f1.getDestination() < f2.getDestination();
+	return DestinationUp()(f1, f2);
 }
 
 /* Criteria: By destination in reverse alphabetical order */
 bool FlightHandler::destinationDown(const Flight& f1, const Flight& f2)
 {
-	return f1.getDestination() > f2.getDestination();
+	return DestinationDown()(f1, f2);
 }
 
 /* Criteri: By Flight time (date) from newest to oldest */
 bool FlightHandler::flightTimeUp(const Flight& f1, const Flight& f2)
 {
-	std::stringstream ss;
-	ss << f1.getFlightTime();
-
-	char temp;
-	int day1, month1, year1, hour1, minute1;
-	ss >> day1 >> temp >> month1 >> temp >> year1 >> temp >> hour1 >> temp >> minute1;
-
-	ss.clear();
-
-	ss << f2.getFlightTime();
-	int day2, month2, year2, hour2, minute2;
-	ss >> day2 >> temp >> month2 >> temp >> year2 >> temp >> hour2 >> temp >> minute2;
-
-	if (year1 == year2)
-		if (month1 == month2)
-			if (day1 == day2)
-				if (hour1 == hour2)
-					return minute1 < minute2;
-				else
-					return hour1 > hour2;
-			else
-				return day1 > day2;
-		else
-			return month1 > month2;
-	else
-		return year1 > year2;
+	return FlightTimeUp()(f1, f2);
 }
 
 /* Criteria: By Flight time (date) from oldest to newest */
 bool FlightHandler::flightTimeDown(const Flight& f1, const Flight& f2)
 {
-	std::stringstream ss;
-	ss << f1.getFlightTime();
-
-	char temp;
-	int day1, month1, year1, hour1, minute1;
-	ss >> day1 >> temp >> month1 >> temp >> year1 >> temp >> hour1 >> temp >> minute1;
-	
-	ss.clear();
-
-	ss << f2.getFlightTime();
-	int day2, month2, year2, hour2, minute2;
-	ss >> day2 >> temp >> month2 >> temp >> year2 >> temp >> hour2 >> temp >> minute2;
-	
-	if (year1 == year2)
-		if (month1 == month2)
-			if (day1 == day2)
-				if (hour1 == hour2)
-					return minute1 < minute2;
-				else
-					return hour1 < hour2;
-			else
-				return day1 < day2;
-		else
-			return month1 < month2;
-	else
-		return year1 < year2;
+	return FlightTimeDown()(f1, f2);
 }
 
 /* Criteria: By Flight nubmer in alphabetical order */
 bool FlightHandler::flightNumberUp(const Flight& f1, const Flight& f2)
 {
-	return f1.getFlightNumber() < f2.getFlightNumber();
+	return FlightNumberUp()(f1, f2);
 }
 
 /* Criteria: By Flight nubmer in reverse alphabetical order */
 bool FlightHandler::flightNumberDown(const Flight& f1, const Flight& f2)
 {
-	return f1.getFlightNumber() > f2.getFlightNumber();
+	return FlightNumberDown()(f1, f2);
 }
 
 /* Criteria: By Gate number in alphabetical order */
 bool FlightHandler::gateNumberUp(const Flight& f1, const Flight& f2)
 {
-	return f1.getGateNumber() < f2.getGateNumber();
+	return GateNumberUp()(f1, f2);
 }
 
 /* Criteria: By Gate number in reverse alphabetical order */
 bool FlightHandler::gateNumberDown(const Flight& f1, const Flight& f2)
 {
-	return f1.getGateNumber() > f2.getGateNumber();
+	return GateNumberDown()(f1, f2);
 }
 
 //-------------------------------------------------------------
@@ -1,7 +1,16 @@
 #ifndef _FLIGHT_HANDLER_INCLUDED_
 #define _FLIGHT_HANDLER_INCLUDED_
 
+#include <vector>
+#include <string>
+#include <cstring>
+
 #include "Flight.h"
+#include "FlightColumns.h"
+#include "MappedFile.h"
+#include "FlightParser.h"
+#include "FlightBinary.h"
+#include "FlightPipeline.h"
 #include "Sorter.h"
 
 /*
@@ -14,40 +23,91 @@ class FlightHandler
 {
 private:
 	/*
-		Pointer to an array of Flight instance pointers.
+		Vector of Flight instances.
+
+		Main data of this class. Flight is fixed width record, so all flights are stored in one
+		contiguous block of memory. It grows while loading, so any number of flights can be loaded.
+	*/
+	std::vector<Flight> flights;
+
+	/*
+		Column (struct of arrays) copy of FlightHandler::flights, one contiguous array per property.
 
-		Main data of this class. Array is internally handled by class.
+		It is rebuilt each time flights are loaded, and used for sorting by one property.
 	*/
-	Flight** flights;
+	FlightColumns columns;
 
 	/*
-		Pointer to an array of strings (const char *) representing Flight objects.
+		Vector of strings (const char *) representing Flight objects.
 
 		This member of class exists to ensure no memory leaks when creating such string
 		representations. In it will be stored Flights in any order. (getFlightsString())
 
-		It's allocation and dealocation is handled internally by class.
+		It is sized to number of loaded flights each time flights are loaded.
 	*/
-	const char** flightsString;
+	mutable std::vector<const char*> flightsString;
 
 	/*
-		Integer which describes how many Flight objects should be loaded from database.
+		Buffer into which rows are rendered while writing (writeFlights), so that file is written with
+		few big writes instead of one stream call per row. It is allocated on first write and reused.
 	*/
-	int flightsToLoad;
+	mutable std::vector<char> writeBuffer;
 
 	/*
 		Boolean flag showing if FlightHandler instance has loaded Flight objects or not.
 	*/
 	bool isLoaded;
 
+	/*
+		Information about file from which flights were loaded, used by appendFlights to parse only rows
+		appended after last load: path, number of bytes parsed, modification time, last bytes parsed
+		(to check that file still begins same way) and flag if file is plain text (only such can be appended).
+	*/
+	std::string sourcePath;
+	size_t sourceBytes;
+	long long sourceTime;
+	std::string sourceTail;
+	bool sourceAppendable;
+
+	/*
+		Function which stores information about file from which flights were loaded (or appended).
+	*/
+	void rememberSource(const char *, size_t, bool);
+
 	/*
 		Function which Handle's clearing array of Flights.
 
-		It ensures that each Flight in array first be deleted from heap. (no memory leaks).
+		It resets each Flight in array to empty one.
 	*/
 	void clearFlights();
 
+	/*
+		Function which parses all rows from char buffer into FlightHandler::flights vector.
+	*/
+	void parseFlights(const char *, const char *, FlightParser::ParseReport * = nullptr);
+
+	/*
+		Function which is called when all Flight objects are loaded (sizes string array, builds columns
+		unless they are already filled).
+	*/
+	void finishLoading(bool = true);
+
 public:
+	/*
+		Size of FlightHandler::writeBuffer in bytes.
+	*/
+	static const size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+	/*
+		Number of last parsed bytes of file which are kept to check that file was only appended.
+	*/
+	static const size_t TAIL_CHECK_SIZE = 64;
+
+	/*
+		Value returned by appendFlights when file had to be loaded again whole.
+	*/
+	enum { RELOADED = -1 };
+
 	/*
 		Enumeration, designed for sort compare function choosing.
 	*/
@@ -55,11 +115,9 @@ public:
 			FLIGHT_NUMBER_UP, FLIGHT_NUMBER_DOWN, GATE_NUMBER_UP, GATE_NUMBER_DOWN };
 
 	/*
-		Constructor, set's initial parameters and does necessary memory allocation.
-
-		It accepts number of Flights to load as a parameter.
+		Constructor, set's initial parameters.
 	*/
-	FlightHandler(int);
+	FlightHandler();
 
 	/*
 		Destructor, does necessary memory cleaning.
@@ -69,25 +127,65 @@ public:
 	/*
 		Function which takes path to database file as a parameter, and tries to read that file.
 
-		It reads from file appropriate number of Flight objects (which creates on Heap), and store they're
-		pointers into FlightHandler::Flights** array.
+		File is memory mapped, and Flight objects are parsed straight from mapped memory into
+		FlightHandler::flights vector (until end of file).
+		If anything goes wrong while reading, it throws std::exception. If report is supplied, rows which
+		are not valid are skipped and recorded in report instead (file errors are still thrown).
+		Binary files (FlightBinary, written by writeBinary) are recognized and loaded without parsing,
+		and gzip compressed text files are inflated while they are parsed.
+	*/
+	void loadFlights(const char *, FlightParser::ParseReport * = nullptr);
+
+	/*
+		Function which takes path to text database file as a parameter, and reads it through FlightPipeline
+		(reading overlaps with parsing, and memory used for reading is fixed whatever size of file is).
+		Meant for files too big to be mapped. Errors and report are same as in loadFlights.
+	*/
+	void streamFlights(const char *, FlightParser::ParseReport * = nullptr);
+
+	/*
+		Function which parses only rows appended to file since it was loaded (or last appended), and adds them
+		after already loaded Flight objects. Returns number of added rows, or RELOADED if file was changed in
+		other way (or is not plain text) so it was loaded again whole. Report is same as in loadFlights.
+	*/
+	int appendFlights(FlightParser::ParseReport * = nullptr);
+
+	/*
+		Function which checks if flights are loaded from file which path is passed.
+	*/
+	bool isLoadedFrom(const char *) const;
+
+	/*
+		Function which reads Flight objects from input stream (with Flight::operator>>) until end of stream.
 		If anything goes wrong while reading, it throws std::exception.
 	*/
-	void loadFlights(const char *);
+	void readFlights(std::istream&);
 
 	/*
 		Function which takes path to file as a parameter and tries to write current Flight objects into that file.
 
-		It open's stream and try to write all data from FlightHandler::Flights** array into that file. If second
+		It open's stream and try to write all data from FlightHandler::flights vector into that file. If second
 		parameter is passed, it does index inverting while writing (writes in specific order).
+		Rows are copied into big buffer and written block by block (no per row stream calls).
 	*/
 	void writeFlights(const char *, const int * = nullptr) const;
 
+	/*
+		Function which writes current Flight objects into binary file (FlightBinary format), which
+		loadFlights reads without parsing. Second parameter is order, same as in writeFlights.
+	*/
+	void writeBinary(const char *, const int * = nullptr) const;
+
 	/*
 		Function which returns isLoaded flag (information if Flights have been loaded).
 	*/
 	bool checkLoaded() const;
 
+	/*
+		Function which returns number of loaded Flight objects.
+	*/
+	int size() const;
+
 	/*
 		This function fills FlightHandler::flightsString array with new information. 
 
@@ -97,13 +195,13 @@ public:
 	const char** getFlightsString(const int * = nullptr) const;
 
 	/*
-		Function which allocates heap memory for new list in which it creates deep copy of instances in self list.
+		Function which allocates heap memory for new list of pointers to instances in self list.
 
 		This function is only dangerous function for MEMORY LEAK because it doesn't clean up after it self,
 		that is left to user. But interface for that is created (FlightHandler::destroyList(Flight **)), so
 		whenever this function is used, after should be called destroyList on same pointer.
 	*/
-	Flight** copyList() const;
+	Flight** copyList();
 
 	/*
 		Function which cleans up after FlightHandler::copyList() function.
@@ -113,6 +211,43 @@ public:
 	*/
 	void destroyList(Flight **) const;
 
+	/*
+		Getter method for column store of loaded Flight objects.
+	*/
+	const FlightColumns& getColumns() const;
+
+	/*
+		Function which sorts loaded Flight objects by one column (chosen by sort criteria enumeration),
+		and fills array of indexes with sorted order. Flight objects are not touched, only column
+		of sort criteria is read.
+	*/
+	void sortByColumn(int, int *, Log * = nullptr) const;
+
+	/*
+		Function which does same as sortByColumn, but with radix sort (Sorter::radixSort) instead of comparing
+		keys. Rows with equal keys keep their order.
+	*/
+	void radixSortByColumn(int, int *, Log * = nullptr) const;
+
+	/*
+		Function which sorts loaded Flight objects by list of sort criteria (by first one, then by second one
+		where first is equal...), and fills array of indexes with sorted order. Criteria keys are packed into
+		one integer key per row, so no compare functions are called.
+	*/
+	void sortByCriteria(const std::vector<int>&, int *, Log * = nullptr) const;
+
+	/*
+		Function which finds first rows of sorted order by one column (for example next few departures), without
+		sorting other rows (Sorter::partialSort). Fills array of indexes and returns number of found rows.
+	*/
+	int partialSortByColumn(int, int, int *) const;
+
+	/*
+		Function which adds rows appended since sorted order of first rows was made (appendFlights) into that
+		order, so array of indexes holds sorted order of all rows. Only new rows are sorted, and then merged in.
+	*/
+	void insertSorted(int, int *, int) const;
+
 	//--------------------------------------------------------------------
 	// Block of compare functions, static functions which will be sent
 	// to Sorter namespace methods when sorting some Flight array.
@@ -146,9 +281,128 @@ public:
 	/* Criteria: By Gate number in reverse alphabetical order */
 	static bool gateNumberDown(const Flight&, const Flight&);
 
+	/* Criteria: By column key in ascending order */
+	template <typename Key>
+	static bool keyUp(const Key& k1, const Key& k2)
+	{
+		return k1 < k2;
+	}
+
+	/* Criteria: By column key in descending order */
+	template <typename Key>
+	static bool keyDown(const Key& k1, const Key& k2)
+	{
+		return k1 > k2;
+	}
+
 	//-------------------------------------------------------------
 	// End of compare function block
 	//-------------------------------------------------------------
+
+	//--------------------------------------------------------------------
+	// Block of compare function objects, same criteria as compare
+	// functions above, but they can be inlined into sort loop (Sorter
+	// algorithms are templated on type of compare function).
+	//
+	// They read Flight fields directly (Flight getters are not inline),
+	// so compare is only strcmp on fixed arrays, or int compare.
+	//---------------------------------------------------------------------
+
+	/* Criteria: By destination in Alphabetical order */
+	struct DestinationUp
+	{
+		bool operator()(const Flight& f1, const Flight& f2) const
+		{
+			return strcmp(f1.destination, f2.destination) < 0;
+		}
+	};
+
+	/* Criteria: By destination in reverse alphabetical order */
+	struct DestinationDown
+	{
+		bool operator()(const Flight& f1, const Flight& f2) const
+		{
+			return strcmp(f1.destination, f2.destination) > 0;
+		}
+	};
+
+	/* Criteria: By Flight time (date) from newest to oldest */
+	struct FlightTimeUp
+	{
+		bool operator()(const Flight& f1, const Flight& f2) const
+		{
+			return f1.timeKey > f2.timeKey;
+		}
+	};
+
+	/* Criteria: By Flight time (date) from oldest to newest */
+	struct FlightTimeDown
+	{
+		bool operator()(const Flight& f1, const Flight& f2) const
+		{
+			return f1.timeKey < f2.timeKey;
+		}
+	};
+
+	/* Criteria: By Flight nubmer in alphabetical order */
+	struct FlightNumberUp
+	{
+		bool operator()(const Flight& f1, const Flight& f2) const
+		{
+			return strcmp(f1.flightNumber, f2.flightNumber) < 0;
+		}
+	};
+
+	/* Criteria: By Flight nubmer in reverse alphabetical order */
+	struct FlightNumberDown
+	{
+		bool operator()(const Flight& f1, const Flight& f2) const
+		{
+			return strcmp(f1.flightNumber, f2.flightNumber) > 0;
+		}
+	};
+
+	/* Criteria: By Gate number in alphabetical order */
+	struct GateNumberUp
+	{
+		bool operator()(const Flight& f1, const Flight& f2) const
+		{
+			return strcmp(f1.gateNumber, f2.gateNumber) < 0;
+		}
+	};
+
+	/* Criteria: By Gate number in reverse alphabetical order */
+	struct GateNumberDown
+	{
+		bool operator()(const Flight& f1, const Flight& f2) const
+		{
+			return strcmp(f1.gateNumber, f2.gateNumber) > 0;
+		}
+	};
+
+	/* Criteria: By column key in ascending order */
+	struct KeyUp
+	{
+		template <typename Key>
+		bool operator()(const Key& k1, const Key& k2) const
+		{
+			return k1 < k2;
+		}
+	};
+
+	/* Criteria: By column key in descending order */
+	struct KeyDown
+	{
+		template <typename Key>
+		bool operator()(const Key& k1, const Key& k2) const
+		{
+			return k1 > k2;
+		}
+	};
+
+	//-------------------------------------------------------------
+	// End of compare function object block
+	//-------------------------------------------------------------
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,219 @@
+#include "FlightParser.h"
+#include "DelimiterScanner.h"
+
+/*
+	Function which returns number of rows in buffer.
+
+	@param begin -> (const char *) begining of buffer.
+	@param end -> (const char *) end of buffer.
+
+	@returns (size_t) number of rows (last row doesn't have to end with new line).
+*/
+size_t FlightParser::countRows(const char* begin, const char* end)
+{
+	if (begin == end)
+		return 0;
+
+	return DelimiterScanner::count(begin, end, '\n') + (end[-1] != '\n' ? 1 : 0);
+}
+
+/*
+	Function which returns begining of first row after given position.
+
+	@param pos -> (const char *) position inside buffer.
+	@param end -> (const char *) end of buffer.
+
+	@returns (const char *) position right after first new line at or after pos, or end of buffer.
+*/
+const char* FlightParser::nextRow(const char* pos, const char* end)
+{
+	const char* found = DelimiterScanner::find(pos, end, '\n');
+	return found == end ? end : found + 1;
+}
+
+/*
+	Function which parses all rows from buffer on calling thread, and appends them to vector.
+
+	Nothing is reserved (vector grows as needed), so it can be called many times for consecutive
+	parts of one file (FlightPipeline). If report is supplied, rows which are not valid are not added
+	to vector, instead their line, offset (offset parameter + position inside buffer) and reason are
+	appended to report, and parsing continues with next row.
+
+	@param begin -> (const char *) begining of buffer.
+	@param end -> (const char *) end of buffer.
+	@param flights -> (std::vector<Flight>&) vector to which Flight objects are appended.
+	@param report -> (ParseReport *) report for non throwing mode, nullptr means throwing mode.
+	@param offset -> (size_t) offset of buffer inside file (only used for report).
+
+	@throws std::exception -> if any row is not valid (only if report is not supplied).
+*/
+void FlightParser::parseRows(const char* begin, const char* end, std::vector<Flight>& flights, ParseReport* report, size_t offset)
+{
+	if (report == nullptr)
+	{
+		while (begin != end)
+		{
+			flights.push_back(Flight());
+			begin = Flight::parse(begin, end, flights.back());
+		}
+		return;
+	}
+
+	const char* start = begin;
+	const char* next;
+	while (begin != end)
+	{
+		flights.push_back(Flight());
+		int status = Flight::tryParse(begin, end, flights.back(), &next);
+		report -> rows++;
+		if (status != Flight::PARSE_OK)
+		{
+			flights.pop_back();
+			ParseError error = { report -> rows, offset + (size_t) (begin - start), status };
+			report -> errors.push_back(error);
+		}
+		begin = next;
+	}
+}
+
+/*
+	Function which parses all rows from buffer on calling thread, and appends them to vector.
+
+	Rows are counted first so that vector is allocated only once.
+	If report is supplied, rows which are not valid are not added to vector, instead their line, offset
+	(from begin) and reason are appended to report, and parsing continues with next row.
+
+	@param begin -> (const char *) begining of buffer.
+	@param end -> (const char *) end of buffer.
+	@param flights -> (std::vector<Flight>&) vector to which Flight objects are appended.
+	@param report -> (ParseReport *) (has default) report for non throwing mode, nullptr means throwing mode.
+
+	@throws std::exception -> if any row is not valid (only if report is not supplied).
+*/
+void FlightParser::parseSerial(const char* begin, const char* end, std::vector<Flight>& flights, ParseReport* report)
+{
+	flights.reserve(flights.size() + countRows(begin, end));
+	parseRows(begin, end, flights, report, 0);
+}
+
+/*
+	Function which splits buffer into chunks and parses each one on its own thread.
+
+	Chunk borders are moved forward to begining of next row, so no row is split between two chunks.
+	Each thread parses its chunk into its own vector (no sharing between threads), and when all
+	threads finish, vectors are appended to result in chunk order, so order of rows is kept.
+	If parsing of any chunk fails, exception of first such chunk is thrown (after all threads finish).
+	In non throwing mode each chunk fills its own report, and chunk reports are merged in the end
+	(lines and offsets are moved by number of rows and bytes of previous chunks).
+
+	@param begin -> (const char *) begining of buffer.
+	@param end -> (const char *) end of buffer.
+	@param flights -> (std::vector<Flight>&) vector to which Flight objects are appended.
+	@param report -> (ParseReport *) (has default) report for non throwing mode, nullptr means throwing mode.
+	@param threads -> (unsigned) (has default) number of threads, 0 means number of hardware threads.
+
+	@throws std::exception -> if any row is not valid (only if report is not supplied).
+*/
+void FlightParser::parseParallel(const char* begin, const char* end, std::vector<Flight>& flights, ParseReport* report, unsigned threads)
+{
+	if (threads == 0)
+		threads = std::thread::hardware_concurrency();
+
+	size_t size = end - begin;
+	size_t chunks = size / MIN_CHUNK_SIZE;
+	if (chunks > threads)
+		chunks = threads;
+
+	if (chunks < 2)
+	{
+		parseSerial(begin, end, flights, report);
+		return;
+	}
+
+	std::vector<const char*> borders(chunks + 1);
+	borders[0] = begin;
+	for (size_t i = 1; i < chunks; i++)
+	{
+		const char* border = nextRow(begin + size / chunks * i, end);
+		borders[i] = (border < borders[i - 1] ? borders[i - 1] : border);
+	}
+	borders[chunks] = end;
+
+	std::vector<std::vector<Flight> > results(chunks);
+	std::vector<ParseReport> reports(report != nullptr ? chunks : 0);
+	std::vector<std::exception_ptr> errors(chunks);
+	std::vector<std::thread> workers;
+
+	for (size_t i = 1; i < chunks; i++)
+		workers.push_back(std::thread([&, i]()
+		{
+			try
+			{
+				parseSerial(borders[i], borders[i + 1], results[i], report != nullptr ? &reports[i] : nullptr);
+			}
+			catch (...)
+			{
+				errors[i] = std::current_exception();
+			}
+		}));
+
+	// first chunk is parsed on calling thread
+	try
+	{
+		parseSerial(borders[0], borders[1], results[0], report != nullptr ? &reports[0] : nullptr);
+	}
+	catch (...)
+	{
+		errors[0] = std::current_exception();
+	}
+
+	for (size_t i = 0; i < workers.size(); i++)
+		workers[i].join();
+
+	for (size_t i = 0; i < chunks; i++)
+		if (errors[i])
+			std::rethrow_exception(errors[i]);
+
+	if (report != nullptr)
+		for (size_t i = 0; i < chunks; i++)
+		{
+			size_t offset = borders[i] - begin;
+			for (size_t j = 0; j < reports[i].errors.size(); j++)
+			{
+				ParseError error = reports[i].errors[j];
+				error.line += report -> rows;
+				error.offset += offset;
+				report -> errors.push_back(error);
+			}
+			report -> rows += reports[i].rows;
+		}
+
+	size_t total = flights.size();
+	for (size_t i = 0; i < chunks; i++)
+		total += results[i].size();
+
+	flights.reserve(total);
+	for (size_t i = 0; i < chunks; i++)
+		flights.insert(flights.end(), results[i].begin(), results[i].end());
+}
+
+/*
+	Function which parses all rows from buffer and appends them to vector.
+
+	Buffers smaller than two chunks (FlightParser::MIN_CHUNK_SIZE) are parsed on calling thread,
+	bigger ones in parallel.
+
+	@param begin -> (const char *) begining of buffer.
+	@param end -> (const char *) end of buffer.
+	@param flights -> (std::vector<Flight>&) vector to which Flight objects are appended.
+	@param report -> (ParseReport *) (has default) report for non throwing mode, nullptr means throwing mode.
+
+	@throws std::exception -> if any row is not valid (only if report is not supplied).
+*/
+void FlightParser::parse(const char* begin, const char* end, std::vector<Flight>& flights, ParseReport* report)
+{
+	if ((size_t) (end - begin) < 2 * MIN_CHUNK_SIZE)
+		parseSerial(begin, end, flights, report);
+	else
+		parseParallel(begin, end, flights, report);
+}
@@ -0,0 +1,86 @@
+#ifndef _FLIGHT_PARSER_INCLUDED_
+#define _FLIGHT_PARSER_INCLUDED_
+
+#include <vector>
+#include <thread>
+#include <exception>
+
+#include "Flight.h"
+
+/*
+	Namespace designed for parsing whole buffers (e.g. memory mapped files) of Flight rows.
+
+	Each row is parsed with Flight::parse. Small buffers are parsed on calling thread, while big
+	ones are split on row boundaries into chunks, each chunk is parsed on its own thread into its
+	own vector, and in the end chunks are joined in same order as they are in buffer.
+
+	@author Acko.
+*/
+namespace FlightParser
+{
+	/*
+		Minimal number of bytes for one chunk, buffers smaller than two chunks are parsed on calling thread.
+	*/
+	const size_t MIN_CHUNK_SIZE = 1 << 20;
+
+	/*
+		Structure which describes one row which is not valid.
+		Line is counted from 1, offset is number of bytes from begining of buffer to begining of row,
+		and reason is status returned by Flight::tryParse() (see Flight::statusMessage()).
+	*/
+	struct ParseError
+	{
+		size_t line;
+		size_t offset;
+		int reason;
+	};
+
+	/*
+		Structure filled by non throwing parse mode, number of rows read (valid and not valid ones)
+		and list of rows which are not valid (in same order as they are in buffer).
+	*/
+	struct ParseReport
+	{
+		size_t rows;
+		std::vector<ParseError> errors;
+
+		ParseReport() : rows(0) {}
+	};
+
+	/*
+		Function which returns number of rows in buffer (last row doesn't have to end with new line).
+	*/
+	size_t countRows(const char *, const char *);
+
+	/*
+		Function which returns begining of first row after given position (or end of buffer).
+	*/
+	const char* nextRow(const char *, const char *);
+
+	/*
+		Function which parses all rows from buffer on calling thread and appends them to vector (vector grows as
+		needed). Last parameter is offset of buffer inside file, added to offsets in report.
+	*/
+	void parseRows(const char *, const char *, std::vector<Flight>&, ParseReport *, size_t);
+
+	/*
+		Function which parses all rows from buffer on calling thread, and appends them to vector.
+		If any row is not valid it throws std::exception, or if report is supplied row is skipped and recorded in it.
+	*/
+	void parseSerial(const char *, const char *, std::vector<Flight>&, ParseReport * = nullptr);
+
+	/*
+		Function which splits buffer into chunks and parses each one on its own thread, Flight objects
+		are appended to vector in same order as they are in buffer. If any row is not valid it throws std::exception,
+		or if report is supplied row is skipped and recorded in it.
+	*/
+	void parseParallel(const char *, const char *, std::vector<Flight>&, ParseReport * = nullptr, unsigned = 0);
+
+	/*
+		Function which parses all rows from buffer and appends them to vector, choosing parallel
+		or serial parsing by size of buffer. Report (if supplied) turns on non throwing mode.
+	*/
+	void parse(const char *, const char *, std::vector<Flight>&, ParseReport * = nullptr);
+};
+
+#endif
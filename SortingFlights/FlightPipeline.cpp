@@ -0,0 +1,325 @@
+#include "FlightPipeline.h"
+#include "DelimiterScanner.h"
+
+#include <fstream>
+#include <mutex>
+#include <condition_variable>
+
+#include "zlib.h"
+
+/*
+	Local class, bounded first in first out queue of block indexes, shared by two threads.
+
+	push waits while queue is full, pop waits while queue is empty. After close() nothing more can be
+	pushed, and pop returns false once queue is empty, so waiting thread can always be released.
+*/
+class BlockQueue
+{
+private:
+	std::vector<size_t> items;
+	size_t head, count;
+	bool closed;
+
+	std::mutex mutex;
+	std::condition_variable notEmpty, notFull;
+
+public:
+	BlockQueue(size_t capacity)
+		: items(capacity), head(0), count(0), closed(false)
+	{
+	}
+
+	/*
+		Adds index at end of queue, returns false if queue is closed.
+	*/
+	bool push(size_t index)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		while (count == items.size() && !closed)
+			notFull.wait(lock);
+		if (closed)
+			return false;
+
+		items[(head + count) % items.size()] = index;
+		count++;
+		notEmpty.notify_one();
+		return true;
+	}
+
+	/*
+		Removes index from begining of queue, returns false if queue is closed and empty.
+	*/
+	bool pop(size_t& index)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		while (count == 0 && !closed)
+			notEmpty.wait(lock);
+		if (count == 0)
+			return false;
+
+		index = items[head];
+		head = (head + 1) % items.size();
+		count--;
+		notFull.notify_one();
+		return true;
+	}
+
+	/*
+		Closes queue and releases all waiting threads.
+	*/
+	void close()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		closed = true;
+		notEmpty.notify_all();
+		notFull.notify_all();
+	}
+};
+
+/*
+	Local structure, one block of file (data is allocated once, size is number of bytes read into it).
+*/
+struct Block
+{
+	std::vector<char> data;
+	size_t size;
+};
+
+/*
+	Local class, source of bytes for reader thread (plain or compressed file).
+*/
+class BlockSource
+{
+public:
+	virtual ~BlockSource() {}
+
+	/*
+		Reads at most size bytes into buffer, returns number of bytes read (less than size only at
+		end of file), or -1 if reading failed.
+	*/
+	virtual long long read(char *, size_t) = 0;
+};
+
+/*
+	Local class, plain file read through stream (stream buffer is off, blocks are read straight into memory).
+*/
+class FileSource : public BlockSource
+{
+private:
+	std::ifstream ifs;
+
+public:
+	FileSource(const char* path)
+	{
+		ifs.rdbuf() -> pubsetbuf(nullptr, 0);
+		ifs.open(path, std::ios::binary);
+		if (!ifs)
+			throw std::exception("Can not open file.");
+	}
+
+	long long read(char* buffer, size_t size)
+	{
+		ifs.read(buffer, size);
+		return ifs.bad() ? -1 : (long long) ifs.gcount();
+	}
+};
+
+/*
+	Local class, gzip compressed file inflated by zlib (gzread), so inflating is done on reader thread.
+*/
+class GzipSource : public BlockSource
+{
+private:
+	gzFile file;
+
+public:
+	GzipSource(const char* path)
+	{
+		file = gzopen(path, "rb");
+		if (file == nullptr)
+			throw std::exception("Can not open file.");
+		gzbuffer(file, 1 << 18);
+	}
+
+	~GzipSource()
+	{
+		gzclose(file);
+	}
+
+	long long read(char* buffer, size_t size)
+	{
+		size_t total = 0;
+		while (total < size)
+		{
+			int count = gzread(file, buffer + total, (unsigned) (size - total));
+			if (count < 0)
+				return -1;
+			if (count == 0)
+				break;
+			total += count;
+		}
+		return (long long) total;
+	}
+};
+
+/*
+	Local function which runs pipeline over given source and appends all rows to vector.
+
+	Reader thread takes free block, reads next BLOCK_SIZE bytes of source into it and passes it to calling
+	thread, which parses every complete row in it (FlightParser::parseRows) and gives block back.
+	Part of last row which is not complete is copied into carry buffer, and rest of that row (up to first
+	new line) is appended to it from next block, so no row is lost or split (carry buffer is never longer
+	than one row). Last row of file doesn't have to end with new line.
+
+	If parsing fails, both queues are closed (so reader stops) and exception is thrown after reader
+	finishes. If reading fails, exception is thrown after blocks already read are parsed.
+
+	@param source -> (BlockSource&) source of bytes.
+	@param flights -> (std::vector<Flight>&) vector to which Flight objects are appended.
+	@param report -> (FlightParser::ParseReport *) report for non throwing mode, nullptr means throwing mode.
+
+	@throws std::exception -> if source can not be read, or any row is not valid (only if report is not supplied).
+
+	@return (size_t) number of bytes read from source.
+*/
+size_t runPipeline(BlockSource& source, std::vector<Flight>& flights, FlightParser::ParseReport* report)
+{
+	using FlightPipeline::BLOCK_SIZE;
+	using FlightPipeline::BLOCK_COUNT;
+
+	std::vector<Block> blocks(BLOCK_COUNT);
+	BlockQueue freeBlocks(BLOCK_COUNT), fullBlocks(BLOCK_COUNT);
+	for (size_t i = 0; i < BLOCK_COUNT; i++)
+	{
+		blocks[i].data.resize(BLOCK_SIZE);
+		freeBlocks.push(i);
+	}
+
+	bool readFailed = false;
+	std::thread reader([&]()
+	{
+		size_t index;
+		while (freeBlocks.pop(index))
+		{
+			long long count = source.read(&blocks[index].data[0], BLOCK_SIZE);
+			if (count < 0)
+			{
+				readFailed = true;
+				break;
+			}
+			blocks[index].size = (size_t) count;
+			if (count > 0 && !fullBlocks.push(index))
+				break;
+			if (blocks[index].size < BLOCK_SIZE)
+				break;
+		}
+		fullBlocks.close();
+	});
+
+	size_t offset = 0;
+	try
+	{
+		std::vector<char> carry;
+		size_t carryOffset = 0, index;
+
+		while (fullBlocks.pop(index))
+		{
+			const char* begin = &blocks[index].data[0];
+			const char* end = begin + blocks[index].size;
+			const char* pos = begin;
+
+			if (!carry.empty())
+			{
+				const char* newline = DelimiterScanner::find(pos, end, '\n');
+				pos = (newline == end ? end : newline + 1);
+				carry.insert(carry.end(), begin, pos);
+				if (newline != end)
+				{
+					FlightParser::parseRows(&carry[0], &carry[0] + carry.size(), flights, report, carryOffset);
+					carry.clear();
+				}
+			}
+
+			const char* last = end;
+			while (last != pos && last[-1] != '\n')
+				--last;
+
+			FlightParser::parseRows(pos, last, flights, report, offset + (pos - begin));
+
+			if (last != end)
+			{
+				if (carry.empty())
+					carryOffset = offset + (last - begin);
+				carry.insert(carry.end(), last, end);
+			}
+
+			offset += blocks[index].size;
+			freeBlocks.push(index);
+		}
+
+		if (!carry.empty())
+			FlightParser::parseRows(&carry[0], &carry[0] + carry.size(), flights, report, carryOffset);
+	}
+	catch (...)
+	{
+		freeBlocks.close();
+		fullBlocks.close();
+		reader.join();
+		throw;
+	}
+
+	reader.join();
+	if (readFailed)
+		throw std::exception("Failed reading file.");
+
+	return offset;
+}
+
+/*
+	Function which reads file which path is passed and appends all rows to vector (see runPipeline).
+
+	@param path -> (const char *) path to file.
+	@param flights -> (std::vector<Flight>&) vector to which Flight objects are appended.
+	@param report -> (FlightParser::ParseReport *) (has default) report for non throwing mode, nullptr means throwing mode.
+
+	@throws std::exception -> if file can not be read, or any row is not valid (only if report is not supplied).
+
+	@return (size_t) number of bytes read.
+*/
+size_t FlightPipeline::load(const char* path, std::vector<Flight>& flights, FlightParser::ParseReport* report)
+{
+	FileSource source(path);
+	return runPipeline(source, flights, report);
+}
+
+/*
+	Function which reads gzip compressed file which path is passed and appends all rows to vector
+	(see runPipeline). File is inflated on reader thread, block by block, so whole decompressed file
+	is never in memory, and nothing is written to disk.
+
+	@param path -> (const char *) path to gzip file.
+	@param flights -> (std::vector<Flight>&) vector to which Flight objects are appended.
+	@param report -> (FlightParser::ParseReport *) (has default) report for non throwing mode, nullptr means throwing mode.
+
+	@throws std::exception -> if file can not be read or inflated, or any row is not valid (only if report is not supplied).
+
+	@return (size_t) number of bytes after inflating.
+*/
+size_t FlightPipeline::loadGzip(const char* path, std::vector<Flight>& flights, FlightParser::ParseReport* report)
+{
+	GzipSource source(path);
+	return runPipeline(source, flights, report);
+}
+
+/*
+	Function which checks if buffer begins with gzip magic bytes (0x1F, 0x8B).
+
+	@param data -> (const char *) begining of buffer.
+	@param size -> (size_t) size of buffer.
+
+	@return (bool) true if buffer is gzip file.
+*/
+bool FlightPipeline::isGzip(const char* data, size_t size)
+{
+	return size >= 2 && (unsigned char) data[0] == 0x1F && (unsigned char) data[1] == 0x8B;
+}
@@ -0,0 +1,51 @@
+#ifndef _FLIGHT_PIPELINE_INCLUDED_
+#define _FLIGHT_PIPELINE_INCLUDED_
+
+#include <vector>
+
+#include "Flight.h"
+#include "FlightParser.h"
+
+/*
+	Namespace designed for loading flight files of any size with fixed amount of memory.
+
+	File is not mapped or read whole, one reader thread reads it into fixed size blocks (there are
+	only BLOCK_COUNT of them) while calling thread parses blocks which are already read, so reading
+	from disk and parsing overlap. Blocks go from reader to parser through bounded queue, and back
+	to reader through another one once they are parsed, so reader waits when parser is behind.
+	Row which is split between two blocks is carried over and parsed when rest of it arrives.
+
+	Gzip compressed files are read same way, only reader thread inflates file (zlib) into blocks
+	instead of reading it, so decompression overlaps with parsing too.
+
+	@author Acko.
+*/
+namespace FlightPipeline
+{
+	/*
+		Size of one block in bytes, and number of blocks (memory used for reading is their product).
+	*/
+	const size_t BLOCK_SIZE = 1 << 20;
+	const size_t BLOCK_COUNT = 3;
+
+	/*
+		Function which reads file which path is passed and appends all rows to vector. If anything goes wrong
+		it throws std::exception, or if report is supplied rows which are not valid are skipped and recorded in it.
+		Returns number of bytes read.
+	*/
+	size_t load(const char *, std::vector<Flight>&, FlightParser::ParseReport * = nullptr);
+
+	/*
+		Function which reads gzip compressed file which path is passed, and appends all rows to vector.
+		Errors and report are same as in FlightPipeline::load (report offsets are offsets in decompressed file).
+		Returns number of bytes after inflating.
+	*/
+	size_t loadGzip(const char *, std::vector<Flight>&, FlightParser::ParseReport * = nullptr);
+
+	/*
+		Function which checks if buffer begins with gzip magic bytes.
+	*/
+	bool isGzip(const char *, size_t);
+};
+
+#endif
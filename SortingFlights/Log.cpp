@@ -198,6 +198,20 @@ void Log::clearEntries()
 	entries.clear();
 }
 
+/*
+	Function which changes number of integers inside each Entry.
+
+	Entries with old number of integers can't be mixed with new ones, so all existing
+	entries are deleted.
+
+	@param numberOfElements -> (int) new number of integers inside each Entry.
+*/
+void Log::setNumberOfElements(int numberOfElements)
+{
+	clearEntries();
+	numberOfElementsInEntry = numberOfElements;
+}
+
 /*
 	Function that returns number of Entry elements stored inside Log instance.
 
@@ -225,44 +239,24 @@ int Log::size()
 */
 void Log::loadEntry(std::istream& _in, Entry& _e)
 {
-	int iterNumber = 0, switchNumber = 0, compareNumber;
-
-	char* buffer = new char[numberOfElementsInEntry + 1];
-	for (int i = 0; i < numberOfElementsInEntry; i++)
-		buffer[i] = 'i';
-	buffer[numberOfElementsInEntry] = '\0';
-
-	StreamReader::InputType it(buffer);
-	delete[] buffer;
-	StreamReader::UserObject* uo = StreamReader::readStream(_in, it);
+	typedef StreamReader::Pattern<StreamReader::Int> IntPattern;
 
 	int* data = new int[numberOfElementsInEntry];
-	for (int i = 0; i < numberOfElementsInEntry; i++)
-		data[i] = * (int *) uo -> data[i];
-
-	StreamReader::clearStream(_in, ';');
-
-	delete uo;
 
 	try
 	{
-		it = StreamReader::InputType("i");
-		uo = StreamReader::readStream(_in, it);
-		iterNumber = * (int *) uo -> data[0];
+		for (int i = 0; i < numberOfElementsInEntry; i++)
+			data[i] = std::get<0>(IntPattern::read(_in));
 
-		delete uo;
 		StreamReader::clearStream(_in, ';');
 
-		uo = StreamReader::readStream(_in, it);
-		switchNumber = * (int *) uo -> data[0];
-
-		delete uo;
+		int iterNumber = std::get<0>(IntPattern::read(_in));
 		StreamReader::clearStream(_in, ';');
 
-		uo = StreamReader::readStream(_in, it);
-		compareNumber = * (int *) uo -> data[0];
+		int switchNumber = std::get<0>(IntPattern::read(_in));
+		StreamReader::clearStream(_in, ';');
 
-		delete uo;
+		int compareNumber = std::get<0>(IntPattern::read(_in));
 		StreamReader::clearStream(_in);
 
 		_e.setData(data);
@@ -275,6 +269,8 @@ void Log::loadEntry(std::istream& _in, Entry& _e)
 		delete[] data;
 		throw e;
 	}
+
+	delete[] data;
 }
 
 //------------------------------------------------------------------------
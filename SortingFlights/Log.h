@@ -209,6 +209,11 @@ public:
 	*/
 	void clearEntries();
 
+	/*
+		Function which changes number of integers inside each Entry (clears all existing entries).
+	*/
+	void setNumberOfElements(int);
+
 	/*
 		Function which returns how many Entry objects are stored inside Log instance.
 	*/
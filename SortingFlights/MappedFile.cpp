@@ -0,0 +1,124 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/*
+	Constructor,
+
+	Opens file which path is passed, and maps it whole into memory (read only).
+
+	@param path -> (const char *) path to file which should be mapped.
+
+	@throws std::exception -> if file can't be opened or mapped.
+*/
+MappedFile::MappedFile(const char* path)
+	: begin(nullptr), length(0), fileHandle(nullptr), mappingHandle(nullptr)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		throw std::exception("Invalid path! Program will load default io path.");
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize))
+	{
+		CloseHandle(file);
+		throw std::exception("Can not read file size.");
+	}
+
+	fileHandle = file;
+	length = (size_t) fileSize.QuadPart;
+	if (length == 0)
+		return;
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr)
+	{
+		CloseHandle(file);
+		throw std::exception("Can not map file.");
+	}
+	mappingHandle = mapping;
+
+	begin = (const char *) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (begin == nullptr)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		throw std::exception("Can not map file.");
+	}
+#else
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		throw std::exception("Invalid path! Program will load default io path.");
+
+	struct stat info;
+	if (fstat(fd, &info) != 0)
+	{
+		close(fd);
+		throw std::exception("Can not read file size.");
+	}
+
+	fileHandle = (void *) (size_t) (fd + 1); // + 1 so that descriptor 0 isn't stored as nullptr
+	length = (size_t) info.st_size;
+	if (length == 0)
+		return;
+
+	void* view = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (view == MAP_FAILED)
+	{
+		close(fd);
+		throw std::exception("Can not map file.");
+	}
+	madvise(view, length, MADV_SEQUENTIAL);
+	begin = (const char *) view;
+#endif
+}
+
+/*
+	Destructor,
+
+	Unmaps file from memory and closes all handles opened in constructor.
+*/
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+	if (begin != nullptr)
+		UnmapViewOfFile(begin);
+	if (mappingHandle != nullptr)
+		CloseHandle((HANDLE) mappingHandle);
+	if (fileHandle != nullptr)
+		CloseHandle((HANDLE) fileHandle);
+#else
+	if (begin != nullptr)
+		munmap((void *) begin, length);
+	if (fileHandle != nullptr)
+		close((int) (size_t) fileHandle - 1);
+#endif
+}
+
+/*
+	Getter method for pointer to first byte of file.
+
+	@returns (const char *) pointer to mapped file content, or nullptr if file is empty.
+*/
+const char* MappedFile::data() const
+{
+	return begin;
+}
+
+/*
+	Getter method for size of file in bytes.
+
+	@returns (size_t) size of file.
+*/
+size_t MappedFile::size() const
+{
+	return length;
+}
@@ -0,0 +1,58 @@
+#ifndef _MAPPED_FILE_INCLUDED_
+#define _MAPPED_FILE_INCLUDED_
+
+#include <stdexcept>
+#include <cstddef>
+
+/*
+	Class MappedFile
+
+	Read only memory mapping of whole file. File content is accessed as one char array,
+	without copying it into program memory and without any stream calls.
+
+	File is mapped in constructor and unmapped in destructor (instance can't be copied).
+	Empty file is valid, then data() returns nullptr and size() returns 0.
+
+	@author Acko.
+*/
+class MappedFile
+{
+private:
+	/* Pointer to first byte of mapped file */
+	const char* begin;
+
+	/* Size of mapped file in bytes */
+	size_t length;
+
+	/* Operating system handles (file and file mapping on Windows, file descriptor otherwise) */
+	void* fileHandle;
+	void* mappingHandle;
+
+	/* Copying is not allowed (mapping is owned by one instance) */
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+public:
+	/*
+		Constructor, opens and maps file which path is passed.
+		If file can't be opened or mapped it throws std::exception.
+	*/
+	MappedFile(const char *);
+
+	/*
+		Destructor, unmaps file and closes handles.
+	*/
+	~MappedFile();
+
+	/*
+		Getter method for pointer to first byte of file.
+	*/
+	const char* data() const;
+
+	/*
+		Getter method for size of file in bytes.
+	*/
+	size_t size() const;
+};
+
+#endif
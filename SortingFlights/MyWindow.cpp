@@ -8,6 +8,8 @@ Fl_Callback* MyWindow::loadListModel_cb = nullptr;
 Fl_Callback* MyWindow::sortListModel_cb = nullptr;
 Fl_Callback* MyWindow::changeSortAlg_cb = nullptr;
 Fl_Callback* MyWindow::changeSortCri_cb = nullptr;
+Fl_Callback* MyWindow::changeSortCri2_cb = nullptr;
+Fl_Callback* MyWindow::changeSortCri3_cb = nullptr;
 Fl_Callback* MyWindow::changeInputPath_cb = nullptr;
 Fl_Callback* MyWindow::changeOutputDir_cb = nullptr;
 Fl_Callback* MyWindow::nextIteration_cb = nullptr;
@@ -37,8 +39,8 @@ Fl_Callback* MyWindow::_exit_cb = (Fl_Callback *) &MyWindow::exitHandle;
 /*
 	Constructor
 */
-MyWindow::MyWindow(int num)
-	: Fl_Window(MyWindow::WIDTH, MyWindow::HEIGHT, "Sorting Flights - Project"), numberOfListElements(num)
+MyWindow::MyWindow()
+	: Fl_Window(MyWindow::WIDTH, MyWindow::HEIGHT, "Sorting Flights - Project")
 {
 	color(Fl_Color(0x1A1A1A00));
 	addMenu();
@@ -111,7 +113,7 @@ MyWindow::~MyWindow()
 	delete[] compareLabel;
 }
 
-void MyWindow::showList(const char** text, int list, const int * mark)
+void MyWindow::showList(const char** text, int numberOfListElements, int list, const int * mark)
 {
 	if (list == ORIGINAL_LIST)
 		originalList -> setText(numberOfListElements, text, mark);
@@ -184,13 +186,16 @@ void MyWindow::addMenu()
 	int *option1 = new int(FlightHandler::DESTINATION_UP), *option2 = new int(FlightHandler::DESTINATION_DOWN),
 		*option3 = new int(FlightHandler::FLIGHT_NUMBER_UP), *option4 = new int(FlightHandler::FLIGHT_NUMBER_DOWN),
 		*option5 = new int(FlightHandler::GATE_NUMBER_UP), *option6 = new int(FlightHandler::GATE_NUMBER_DOWN),
-		*option7 = new int(FlightHandler::FLIGHT_TIME_UP), *option8 = new int(FlightHandler::FLIGHT_TIME_DOWN);
+		*option7 = new int(FlightHandler::FLIGHT_TIME_UP), *option8 = new int(FlightHandler::FLIGHT_TIME_DOWN),
+		*option0 = new int(0);
 
 	menu -> add("Options/Sort", 0, sortListModel_cb, nullptr); // external
 	menu -> add("Options/Load Data", 0, loadListModel_cb, nullptr); // external
 	menu -> add("Options/----------------------------------------", 0, nullptr, nullptr, FL_MENU_INACTIVE);
 	menu -> add("Options/Sort Algorithm/Selection Sort\t", 0, changeSortAlg_cb, (void *) option1, FL_MENU_RADIO + FL_MENU_CHECK); // MAKE RADIO
 	menu -> add("Options/Sort Algorithm/Quick Sort\t", 0, changeSortAlg_cb, (void *) option2, FL_MENU_RADIO); // MAKE RADIO
+	menu -> add("Options/Sort Algorithm/Radix Sort\t", 0, changeSortAlg_cb, (void *) option3, FL_MENU_RADIO); // MAKE RADIO
+	menu -> add("Options/Sort Algorithm/Tim Sort (Stable)\t", 0, changeSortAlg_cb, (void *) option4, FL_MENU_RADIO); // MAKE RADIO
 	menu -> add("Options/Sort Criteria/Destination Up\t", 0 , changeSortCri_cb, (void *) option1, FL_MENU_RADIO + FL_MENU_CHECK);
 	menu -> add("Options/Sort Criteria/Destination Down\t", 0, changeSortCri_cb, (void *) option2, FL_MENU_RADIO);
 	menu -> add("Options/Sort Criteria/Flight Number Up\t", 0, changeSortCri_cb, (void *) option3, FL_MENU_RADIO);
@@ -199,6 +204,24 @@ void MyWindow::addMenu()
 	menu -> add("Options/Sort Criteria/Gate Number Down\t", 0, changeSortCri_cb, (void *) option6, FL_MENU_RADIO);
 	menu -> add("Options/Sort Criteria/Date Up\t", 0, changeSortCri_cb, (void *) option7, FL_MENU_RADIO);
 	menu -> add("Options/Sort Criteria/Date Down\t", 0, changeSortCri_cb, (void *) option8, FL_MENU_RADIO);
+	menu -> add("Options/Then By/None\t", 0, changeSortCri2_cb, (void *) option0, FL_MENU_RADIO + FL_MENU_CHECK);
+	menu -> add("Options/Then By/Destination Up\t", 0, changeSortCri2_cb, (void *) option1, FL_MENU_RADIO);
+	menu -> add("Options/Then By/Destination Down\t", 0, changeSortCri2_cb, (void *) option2, FL_MENU_RADIO);
+	menu -> add("Options/Then By/Flight Number Up\t", 0, changeSortCri2_cb, (void *) option3, FL_MENU_RADIO);
+	menu -> add("Options/Then By/Flight Number Down\t", 0, changeSortCri2_cb, (void *) option4, FL_MENU_RADIO);
+	menu -> add("Options/Then By/Gate Number Up\t", 0, changeSortCri2_cb, (void *) option5, FL_MENU_RADIO);
+	menu -> add("Options/Then By/Gate Number Down\t", 0, changeSortCri2_cb, (void *) option6, FL_MENU_RADIO);
+	menu -> add("Options/Then By/Date Up\t", 0, changeSortCri2_cb, (void *) option7, FL_MENU_RADIO);
+	menu -> add("Options/Then By/Date Down\t", 0, changeSortCri2_cb, (void *) option8, FL_MENU_RADIO);
+	menu -> add("Options/And Then By/None\t", 0, changeSortCri3_cb, (void *) option0, FL_MENU_RADIO + FL_MENU_CHECK);
+	menu -> add("Options/And Then By/Destination Up\t", 0, changeSortCri3_cb, (void *) option1, FL_MENU_RADIO);
+	menu -> add("Options/And Then By/Destination Down\t", 0, changeSortCri3_cb, (void *) option2, FL_MENU_RADIO);
+	menu -> add("Options/And Then By/Flight Number Up\t", 0, changeSortCri3_cb, (void *) option3, FL_MENU_RADIO);
+	menu -> add("Options/And Then By/Flight Number Down\t", 0, changeSortCri3_cb, (void *) option4, FL_MENU_RADIO);
+	menu -> add("Options/And Then By/Gate Number Up\t", 0, changeSortCri3_cb, (void *) option5, FL_MENU_RADIO);
+	menu -> add("Options/And Then By/Gate Number Down\t", 0, changeSortCri3_cb, (void *) option6, FL_MENU_RADIO);
+	menu -> add("Options/And Then By/Date Up\t", 0, changeSortCri3_cb, (void *) option7, FL_MENU_RADIO);
+	menu -> add("Options/And Then By/Date Down\t", 0, changeSortCri3_cb, (void *) option8, FL_MENU_RADIO);
 	menu -> add("Options/-----------------------------------------", 0, nullptr, nullptr, FL_MENU_INACTIVE);
 	menu -> add("Options/Change Input File", 0, _changeInputPath_cb, nullptr); // internal!
 	menu -> add("Options/Change Output Directory", 0, _changeOutputDir_cb, nullptr); // internal
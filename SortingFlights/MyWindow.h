@@ -30,8 +30,6 @@ class MyWindow : public Fl_Window
 	CustomButton* loadList;
 	CustomButton* sortList;
 
-	int numberOfListElements;
-
 	void addMenu();
 public:
 	static const int WIDTH = 1200;
@@ -43,6 +41,8 @@ public:
 	static Fl_Callback* sortListModel_cb;
 	static Fl_Callback* changeSortAlg_cb;
 	static Fl_Callback* changeSortCri_cb;
+	static Fl_Callback* changeSortCri2_cb;
+	static Fl_Callback* changeSortCri3_cb;
 	static Fl_Callback* changeInputPath_cb;
 	static Fl_Callback* changeOutputDir_cb;
 	static Fl_Callback* nextIteration_cb;
@@ -66,10 +66,10 @@ public:
 
 	int handle(int);
 
-	MyWindow(int);
+	MyWindow();
 	~MyWindow();
 
-	void showList(const char **, int, const int * = nullptr);
+	void showList(const char **, int, int, const int * = nullptr);
 	void clearList(int);
 	void updateLabels(int, int, int);
 };
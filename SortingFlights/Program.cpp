@@ -13,6 +13,21 @@ bool dirExists(const std::string& dirName_in)
   return false;    // this is not a directory!
 }
 
+/*
+	Local function which sorts list of Flight pointers with sort algorithm chosen in menu (selection, tim or
+	quick sort), using compare function object.
+*/
+template <typename Compare>
+void sortFlights(int sortType, Flight** list, size_t size, Compare compare, Log* log)
+{
+	if (sortType == Program::SELECTION)
+		Sorter::selectionSort(list, size, compare, log);
+	else if (sortType == Program::TIM)
+		Sorter::timSort(list, size, compare, log);
+	else
+		Sorter::quickSort(list, size, compare, log);
+}
+
 //------------------------------------------------------------
 // Setting default static variables and constants
 //------------------------------------------------------------
@@ -29,8 +44,6 @@ const char* Program::TEMP_FILE = "temp";
 int Program::DEFAULT_SORT = Program::SELECTION;
 int Program::DEFAULT_CRITERIA = FlightHandler::DESTINATION_UP;
 
-const int Program::FLIGHTS_TO_LOAD = 10;
-
 //--------------------------------------------------------------
 // END OF setting default static variables and constants
 //--------------------------------------------------------------
@@ -55,11 +68,13 @@ Program::Program()
 
 	sortType = DEFAULT_SORT;
 	sortCriteria = DEFAULT_CRITERIA;
+	sortCriteria2 = 0;
+	sortCriteria3 = 0;
 
 	try
 	{
-		log = new Log(FLIGHTS_TO_LOAD);
-		fh = new FlightHandler(FLIGHTS_TO_LOAD);
+		log = new Log(0); // resized to number of loaded flights before each sort
+		fh = new FlightHandler();
 		connectView();
 		initView();
 	}
@@ -142,7 +157,7 @@ void Program::start()
 
 void Program::initView()
 {
-	win = new MyWindow(FLIGHTS_TO_LOAD);
+	win = new MyWindow();
 }
 
 void Program::destructView()
@@ -168,9 +183,9 @@ void Program::show()
 void Program::showList(int index, int list, const int* mark)
 {
 	if (sorted)
-		win -> showList(fh -> getFlightsString(log -> getData(index)), list, mark);
+		win -> showList(fh -> getFlightsString(log -> getData(index)), fh -> size(), list, mark);
 	else
-		win -> showList(fh -> getFlightsString(), list, mark);
+		win -> showList(fh -> getFlightsString(), fh -> size(), list, mark);
 }
 
 bool Program::isLoaded()
@@ -197,6 +212,8 @@ void Program::connectView()
 	MyWindow::sortListModel_cb = (Fl_Callback *) &Program::sortListModelHandle;
 	MyWindow::changeSortAlg_cb = (Fl_Callback *) &Program::changeSortAlgHandle;
 	MyWindow::changeSortCri_cb = (Fl_Callback *) &Program::changeSortCriHandle;
+	MyWindow::changeSortCri2_cb = (Fl_Callback *) &Program::changeSortCri2Handle;
+	MyWindow::changeSortCri3_cb = (Fl_Callback *) &Program::changeSortCri3Handle;
 	MyWindow::changeInputPath_cb = (Fl_Callback *) &Program::changeInputPathHandle;
 	MyWindow::changeOutputDir_cb = (Fl_Callback *) &Program::changeOutputDirHandle;
 }
@@ -309,7 +326,11 @@ void Program::loadListModelHandle(Fl_Widget *, void* data)
 		Program::getInstance() -> win -> clearList(MyWindow::ORIGINAL_LIST);
 		Program::getInstance() -> win -> clearList(MyWindow::PROGRESS_LIST);
 		Program::getInstance() -> updateLabels(0, 0, 0);
-		Program::getInstance() -> fh -> loadFlights(Program::getInstance() -> inputFile);
+		// same file is only appended to (rows added since last load are parsed), other file is loaded whole
+		if (Program::getInstance() -> fh -> isLoadedFrom(Program::getInstance() -> inputFile))
+			Program::getInstance() -> fh -> appendFlights();
+		else
+			Program::getInstance() -> fh -> loadFlights(Program::getInstance() -> inputFile);
 		Program::getInstance() -> showList(0, MyWindow::ORIGINAL_LIST, nullptr);
 	}
 	catch (std::exception&)
@@ -326,50 +347,67 @@ void Program::sortListModelHandle(Fl_Widget *, void* userData)
 	{
 		try
 		{
-			p -> log -> clearEntries();
+			p -> log -> setNumberOfElements(p -> fh -> size());
 
-			void (* sort) (Flight**, size_t, bool (*) (const Flight&, const Flight&), Log *);
-			bool (* compare) (const Flight&, const Flight&);
+			// radix sort doesn't compare Flight objects, it sorts column of sort criteria (or packed keys of
+			// all criteria if more than one is chosen, whichever sort algorithm is selected)
+			if (p -> sortType == RADIX || p -> sortCriteria2 != 0 || p -> sortCriteria3 != 0)
+			{
+				std::vector<int> indexes(p -> fh -> size());
+				if (p -> sortCriteria2 != 0 || p -> sortCriteria3 != 0)
+				{
+					std::vector<int> criteria(1, p -> sortCriteria);
+					if (p -> sortCriteria2 != 0)
+						criteria.push_back(p -> sortCriteria2);
+					if (p -> sortCriteria3 != 0)
+						criteria.push_back(p -> sortCriteria3);
+					p -> fh -> sortByCriteria(criteria, indexes.data(), p -> log);
+				}
+				else
+					p -> fh -> radixSortByColumn(p -> sortCriteria, indexes.data(), p -> log);
+				p -> sorted = true;
+				p -> currentSwitch = 0;
+				p -> showList(p -> currentSwitch, MyWindow::PROGRESS_LIST);
+				p -> updateLabels(p -> log -> getIterNumber(p -> currentSwitch), p -> log -> getSwitchNumber(p -> currentSwitch),
+									p -> log -> getCompareNumber(p -> currentSwitch));
+				return;
+			}
 
-			if (p -> sortType == SELECTION)
-				sort = &Sorter::selectionSort;
-			else
-				sort = &Sorter::quickSort;
+			Flight** copyList = p -> fh -> copyList();
+			size_t size = p -> fh -> size();
 
+			// compare function objects, so compare is inlined into sort loop
 			switch (p -> sortCriteria)
 			{
 			case FlightHandler::DESTINATION_UP:
-				compare = &FlightHandler::destinationUp;
+				sortFlights(p -> sortType, copyList, size, FlightHandler::DestinationUp(), p -> log);
 				break;
 			case FlightHandler::DESTINATION_DOWN:
-				compare = &FlightHandler::destinationDown;
+				sortFlights(p -> sortType, copyList, size, FlightHandler::DestinationDown(), p -> log);
 				break;
 			case FlightHandler::FLIGHT_NUMBER_UP:
-				compare = &FlightHandler::flightNumberUp;
+				sortFlights(p -> sortType, copyList, size, FlightHandler::FlightNumberUp(), p -> log);
 				break;
 			case FlightHandler::FLIGHT_NUMBER_DOWN:
-				compare = &FlightHandler::flightNumberDown;
+				sortFlights(p -> sortType, copyList, size, FlightHandler::FlightNumberDown(), p -> log);
 				break;
 			case FlightHandler::FLIGHT_TIME_UP:
-				compare = &FlightHandler::flightTimeUp;
+				sortFlights(p -> sortType, copyList, size, FlightHandler::FlightTimeUp(), p -> log);
 				break;
 			case FlightHandler::FLIGHT_TIME_DOWN:
-				compare = &FlightHandler::flightTimeDown;
+				sortFlights(p -> sortType, copyList, size, FlightHandler::FlightTimeDown(), p -> log);
 				break;
 			case FlightHandler::GATE_NUMBER_UP:
-				compare = &FlightHandler::gateNumberUp;
+				sortFlights(p -> sortType, copyList, size, FlightHandler::GateNumberUp(), p -> log);
 				break;
 			case FlightHandler::GATE_NUMBER_DOWN:
-				compare = &FlightHandler::gateNumberDown;
+				sortFlights(p -> sortType, copyList, size, FlightHandler::GateNumberDown(), p -> log);
 				break;
 			default:
-				compare = nullptr;
-				break;
+				p -> fh -> destroyList(copyList);
+				throw std::exception("Unknown sort criteria.");
 			}
 
-			Flight** copyList = p -> fh -> copyList();
-
-			sort(copyList, FLIGHTS_TO_LOAD, compare, p -> log);
 			p -> sorted = true;
 			p -> currentSwitch = 0;
 			p -> showList(p -> currentSwitch, MyWindow::PROGRESS_LIST);
@@ -402,6 +440,20 @@ void Program::changeSortCriHandle(Fl_Widget *, void* data)
 	std::cout << "SORT: " << p -> sortCriteria << std::endl;
 }
 
+void Program::changeSortCri2Handle(Fl_Widget *, void* data)
+{
+	Program* p = Program::getInstance();
+	int* option = (int *) data;
+	p -> sortCriteria2 = *option;
+}
+
+void Program::changeSortCri3Handle(Fl_Widget *, void* data)
+{
+	Program* p = Program::getInstance();
+	int* option = (int *) data;
+	p -> sortCriteria3 = *option;
+}
+
 void Program::changeInputPathHandle(Fl_Widget* w, void* data)
 {
 	int status = * (int *) data;
@@ -38,12 +38,10 @@ private:
 	Program();
 	
 public:
-	enum { SELECTION = 1, QUICK };
+	enum { SELECTION = 1, QUICK, RADIX, TIM };
 
 	static Program* getInstance();
 
-	static const int FLIGHTS_TO_LOAD;
-
 	char inputFolder[MAX_STRING_LENGTH];
 	char inputFile[MAX_STRING_LENGTH];
 
@@ -55,6 +53,8 @@ public:
 
 	int sortType;
 	int sortCriteria;
+	int sortCriteria2;
+	int sortCriteria3;
 
 	~Program();
 
@@ -91,6 +91,8 @@ public:
 	static void sortListModelHandle(Fl_Widget *, void *);
 	static void changeSortAlgHandle(Fl_Widget *, void *);
 	static void changeSortCriHandle(Fl_Widget *, void *);
+	static void changeSortCri2Handle(Fl_Widget *, void *);
+	static void changeSortCri3Handle(Fl_Widget *, void *);
 	static void changeInputPathHandle(Fl_Widget *, void *);
 	static void changeOutputDirHandle(Fl_Widget *, void *);
 
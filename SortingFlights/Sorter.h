@@ -1,14 +1,29 @@
 #ifndef _SORTER_INCLUDED_
 #define _SORTER_INCLUDED_
 
+#include <vector>
+#include <utility>
+#include <cstring>
+#include <algorithm>
+
 #include "Log.h"
+#include "TaskPool.h"
 
 /*
 	Namespace which handles sorting arrays of data.
 
-	It contains two main methods selectionSort and quickSort, along with defaultCompare, and recursive quickSort().
+	It contains two main methods selectionSort and quickSort, along with defaultCompare, and quickSort() range function
+	(with insertionSort and heapSort which it uses for small and badly partitioned ranges).
+	It also contains radixSort, which is not comparison sort, it sorts unsigned integer keys byte by byte,
+	and multikeySort which sorts strings char by char. parallelSort is merge sort which uses all cores (TaskPool),
+	and timSort is stable merge sort which takes advantage of already sorted parts of array.
+	partialSort and nthElement don't sort whole array, they only find few smallest elements (or one element
+	at given position), which is cheaper than full sort.
 	Whole namespace is designed on template idea, it is created as generic as possible. Both sorts algorithms
 	work with array of Type *, and both of them fetch comparing function thorugh parameters.
+	Sorts are templated on type of compare function too, so function object (with inline operator()) can be
+	passed and inlined into sort loop. Overloads which take pointer to a compare function (with defaultCompare
+	as default) are kept, they only call same sorts.
 
 	Also both sort algorithms fetch Log * (this is non generic part of code), which if it is passed, is used
 	to store each change in sorting process.
@@ -39,11 +54,11 @@ namespace Sorter
 
 		@param items -> (Type **) array of Type pointers.
 		@param size -> (size_t) size of an array to be sorted.
-		@param compare -> (bool (*)(const Type&, const Type&)) (has default) pointer to a compare function.
+		@param compare -> (Compare) compare function or function object (bool operator()(const Type&, const Type&)).
 		@param log -> (Log *) (has default) pointer to an Log instance which is used for tracking sort moves.
 	*/
-	template <typename Type>
-	void selectionSort(Type* items[], size_t size, bool (*compare)(const Type&, const Type&) = &defaultCompare, Log* log = nullptr)
+	template <typename Type, typename Compare>
+	void selectionSort(Type* items[], size_t size, Compare compare, Log* log = nullptr)
 	{
 		int* logList = new int[size];
 		for (unsigned int i = 0; i < size; i++)
@@ -51,9 +66,10 @@ namespace Sorter
 
 		int iterNum = 0, switchNumber = 0, compareNum = 0;
 
-		log -> createEntry(logList, 0, 0, 0);
+		if (log)
+			log -> createEntry(logList, 0, 0, 0);
 
-		for (unsigned int i = 0; i < size - 1; i++)
+		for (unsigned int i = 0; i + 1 < size; i++)
 		{
 			iterNum++;
 			int min = i;
@@ -87,12 +103,216 @@ namespace Sorter
 	}
 
 	/*
-		Quick sort algorithm. 
+		Overload of selectionSort for pointer to a compare function (has default), see selectionSort above.
+	*/
+	template <typename Type>
+	void selectionSort(Type* items[], size_t size, bool (*compare)(const Type&, const Type&) = &defaultCompare, Log* log = nullptr)
+	{
+		selectionSort<Type, bool (*)(const Type&, const Type&)>(items, size, compare, log);
+	}
+
+	/*
+		Number of elements under which quick sort stops partitioning and finishes range with insertion sort.
+	*/
+	const int INSERTION_CUTOFF = 16;
+
+	/*
+		Sort Algorithms Support.
+
+		Function which switches two elements of array. If sort is tracked (info is not nullptr) it also
+		switches same two elements of index list, and stores new Entry into Log (same as each switch of
+		selection sort).
+
+		@param arr -> (T **) array of T pointers.
+		@param i -> (int) index of first element.
+		@param j -> (int) index of second element.
+		@param log -> (Log *) pointer to an Log instance (used only if info is not nullptr).
+		@param info -> (int *) pointer to an integer array with 3 values (iteration number, switch number, compare number), or nullptr.
+		@param indexes -> (int *) pointer to an integer array which presents indexes of original list which is being sorted.
+	*/
+	template <typename T>
+	inline void switchItems(T** arr, int i, int j, Log* log, int* info, int* indexes)
+	{
+		T* temp = arr[i];
+		arr[i] = arr[j];
+		arr[j] = temp;
+
+		if (info)
+		{
+			int index = indexes[i];
+			indexes[i] = indexes[j];
+			indexes[j] = index;
+			log -> createEntry(indexes, info[0], ++info[1], info[2]);
+		}
+	}
+
+	/*
+		Sort Algorithms Support.
+
+		Function which compares two elements with compare function, and counts compare if sort is tracked.
+
+		@param t1 -> (const T&) first element.
+		@param t2 -> (const T&) second element.
+		@param compare -> (bool (*)(const T&, const T&)) pointer to a compare function.
+		@param info -> (int *) pointer to an integer array with 3 values, or nullptr.
+
+		@returns (bool) result of compare(t1, t2).
+	*/
+	template <typename T, typename Compare>
+	inline bool compareItems(const T& t1, const T& t2, Compare compare, int* info)
+	{
+		if (info)
+			info[2]++;
+		return compare(t1, t2);
+	}
+
+	/*
+		Insertion sort of range [first, last] (both included), used by quick sort for small ranges.
+		Each element is moved to its place by switching it with previous one, so each move is tracked.
+
+		@param arr -> (T **) array of T pointers.
+		@param first -> (int) index of first element of range.
+		@param last -> (int) index of last element of range.
+		@param compare -> (bool (*)(const T&, const T&)) pointer to a compare function.
+		@param log -> (Log *) pointer to an Log instance, or nullptr.
+		@param info -> (int *) pointer to an integer array with 3 values, or nullptr.
+		@param indexes -> (int *) pointer to an integer array which presents indexes of original list, or nullptr.
+	*/
+	template <typename T, typename Compare>
+	void insertionSort(T** arr, int first, int last, Compare compare, Log* log, int* info, int* indexes)
+	{
+		for (int i = first + 1; i <= last; i++)
+		{
+			if (info)
+				info[0]++;
+			for (int j = i; j > first && compareItems<T>(*arr[j], *arr[j - 1], compare, info); j--)
+				switchItems<T>(arr, j, j - 1, log, info, indexes);
+		}
+	}
+
+	/*
+		Function which moves element of max heap (biggest element at top) down while any of its children is
+		bigger than it. Heap is stored in range [first, first + size), children of node are 2 * node + 1 and
+		2 * node + 2 (relative to first).
+
+		@param arr -> (T **) array of T pointers.
+		@param first -> (int) index of first element of heap.
+		@param node -> (int) index of node (relative to first) which is moved down.
+		@param size -> (int) number of elements in heap.
+		@param compare -> (Compare) compare function or function object.
+		@param log -> (Log *) pointer to an Log instance, or nullptr.
+		@param info -> (int *) pointer to an integer array with 3 values, or nullptr.
+		@param indexes -> (int *) pointer to an integer array which presents indexes of original list, or nullptr.
+	*/
+	template <typename T, typename Compare>
+	void siftDown(T** arr, int first, int node, int size, Compare compare, Log* log, int* info, int* indexes)
+	{
+		for (int child = 2 * node + 1; child < size; node = child, child = 2 * node + 1)
+		{
+			if (child + 1 < size && compareItems<T>(*arr[first + child], *arr[first + child + 1], compare, info))
+				child++;
+			if (!compareItems<T>(*arr[first + node], *arr[first + child], compare, info))
+				return;
+			switchItems<T>(arr, first + node, first + child, log, info, indexes);
+		}
+	}
+
+	/*
+		Heap sort of range [first, last] (both included), used by quick sort when partitioning goes too deep
+		(so whole sort stays O(n log n) whatever the input is).
+
+		@param arr -> (T **) array of T pointers.
+		@param first -> (int) index of first element of range.
+		@param last -> (int) index of last element of range.
+		@param compare -> (bool (*)(const T&, const T&)) pointer to a compare function.
+		@param log -> (Log *) pointer to an Log instance, or nullptr.
+		@param info -> (int *) pointer to an integer array with 3 values, or nullptr.
+		@param indexes -> (int *) pointer to an integer array which presents indexes of original list, or nullptr.
+	*/
+	template <typename T, typename Compare>
+	void heapSort(T** arr, int first, int last, Compare compare, Log* log, int* info, int* indexes)
+	{
+		int size = last - first + 1;
+
+		for (int node = size / 2 - 1; node >= 0; node--)
+			siftDown<T>(arr, first, node, size, compare, log, info, indexes);
+
+		for (int end = size - 1; end > 0; end--)
+		{
+			if (info)
+				info[0]++;
+			switchItems<T>(arr, first, first + end, log, info, indexes);
+			siftDown<T>(arr, first, 0, end, compare, log, info, indexes);
+		}
+	}
+
+	/*
+		Function which partitions range [first, last] (Hoare scheme) around median of first, middle and last
+		element, used by quick sort and nthElement. Range must have at least 3 elements.
+
+		First and last element are ordered by median selection, so they stop both scans and no bounds checks
+		are needed inside partitioning.
+
+		@param arr -> (T **) array of T pointers.
+		@param first -> (int) index of first element of range.
+		@param last -> (int) index of last element of range.
+		@param compare -> (Compare) compare function or function object.
+		@param log -> (Log *) pointer to an Log instance, or nullptr.
+		@param info -> (int *) pointer to an integer array with 3 values, or nullptr.
+		@param indexes -> (int *) pointer to an integer array which presents indexes of original list, or nullptr.
+
+		@returns (int) index j, after partitioning [first, j] <= pivot <= [j + 1, last] (both parts are not empty).
+	*/
+	template <typename T, typename Compare>
+	int partition(T** arr, int first, int last, Compare compare, Log* log, int* info, int* indexes)
+	{
+		// median of three, after this arr[first] <= arr[middle] <= arr[last]
+		int middle = first + (last - first) / 2;
+		if (compareItems<T>(*arr[middle], *arr[first], compare, info))
+			switchItems<T>(arr, middle, first, log, info, indexes);
+		if (compareItems<T>(*arr[last], *arr[middle], compare, info))
+		{
+			switchItems<T>(arr, last, middle, log, info, indexes);
+			if (compareItems<T>(*arr[middle], *arr[first], compare, info))
+				switchItems<T>(arr, middle, first, log, info, indexes);
+		}
+
+		T* pivot = arr[middle];
+		int i = first, j = last;
+		while (true)
+		{
+			while (compareItems<T>(*arr[++i], *pivot, compare, info));
+			while (compareItems<T>(*pivot, *arr[--j], compare, info));
+			if (i >= j)
+				return j;
+			switchItems<T>(arr, i, j, log, info, indexes);
+		}
+	}
+
+	/*
+		Quick Sort Algorithm Support, declaration (defined below public interface function).
+	*/
+	template <typename T, typename Compare>
+	static void quickSort(T** arr, int first, int last, int depth, Compare compare, Log* log = nullptr, int* info = nullptr, int* indexes = nullptr);
+
+	/*
+		Size of explicit stack of quick sort ranges. Each pushed range is at least as big as the one which is
+		sorted next, so ranges on stack at least double in size from top to bottom, and no more than
+		log2(size) of them can be pending at once (31 for int indexes).
+	*/
+	static const int QUICK_STACK_SIZE = 64;
 
-		This is public interface function, other one is recursive call, shouldn't be called from outside.
+	/*
+		Quick sort algorithm (introsort).
 
-		Basic quick sort, with added templates for T which it sorts, and added support for Log *.
-		It doesn't do any random mixing on begining, and picking of pivot is trivial, just pick last from right.
+		This is public interface function, other one (range function) shouldn't be called from outside.
+
+		Quick sort with added templates for T which it sorts, and added support for Log *.
+		Pivot is median of first, middle and last element, so sorted and reverse sorted lists are split in
+		halves. Sorting is not recursive, bigger part of each partition is pushed on small fixed size stack
+		and smaller one is partitioned next, so at most log2(size) ranges are pending and sorting uses same
+		amount of stack for any input. Ranges smaller than INSERTION_CUTOFF are finished with insertion sort, and if
+		partitioning goes deeper than 2 * log2(size) (bad pivots) range is finished with heap sort.
 
 		If Log * is suplied as parameter, this sorting function tracks down its own iteration number, 
 		switch number and compare number, and stores it inside Log *.
@@ -103,12 +323,16 @@ namespace Sorter
 
 		@param arr -> (T **) array of T pointers.
 		@param size -> (size_t) size of an array to be sorted.
-		@param compare -> (bool (*)(const Type&, const Type&)) (has default) pointer to a compare function.
+		@param compare -> (Compare) compare function or function object (bool operator()(const T&, const T&)).
 		@param log -> (Log *) (has default) pointer to an Log instance which is used for tracking sort moves.
 	*/
-	template <typename T> 
-	static void quickSort(T** arr, size_t size, bool (*compare)(const T&, const T&) = &defaultCompare, Log* log = nullptr)
+	template <typename T, typename Compare>
+	static void quickSort(T** arr, size_t size, Compare compare, Log* log = nullptr)
 	{
+		int depth = 0;
+		for (size_t n = size; n > 1; n >>= 1)
+			depth += 2;
+
 		if (log != nullptr)
 		{
 			int* indexes = new int[size];
@@ -117,75 +341,951 @@ namespace Sorter
 			log -> createEntry(indexes, 0, 0, 0);
 
 			int info[] = {0, 0, 0}; // iterNum, switchNum, compareNum
-			quickSort<T>(arr, 0, size - 1, compare, log, info, indexes); // call to private function member
+			quickSort<T>(arr, 0, (int) size - 1, depth, compare, log, info, indexes); // call to private function member
 			// log -> writeData();
 			delete[] indexes;
 		}
-		else
-			quickSort<T>(arr, 0, size - 1, compare);
+		else if (size > 0)
+			quickSort<T>(arr, 0, (int) size - 1, depth, compare);
+	}
+
+	/*
+		Overload of quickSort for pointer to a compare function (has default), see quickSort above.
+	*/
+	template <typename T>
+	static void quickSort(T** arr, size_t size, bool (*compare)(const T&, const T&) = &defaultCompare, Log* log = nullptr)
+	{
+		quickSort<T, bool (*)(const T&, const T&)>(arr, size, compare, log);
 	}
 
 	/*
 		Quick Sort Algorithm Support.
 
-		This is "private" recursive function which is called from quick sort "public" interface, and by itself.
+		This is "private" function which is called from quick sort "public" interface.
 		This function does sorting job. Upper one just provides "public" interface.
 
+		Range is partitioned (see partition), bigger part is pushed on explicit stack (with its own remaining
+		depth) and smaller one is partitioned by next pass of loop. When range is small enough it is finished
+		with insertion sort (or with heap sort when depth runs out) and next range is popped from stack.
+		Ranges are sorted in same order as recursive version would sort them (smaller part first), so Log
+		gets same entries.
+
 		@param arr -> (T **) array of T pointers.
-		@param size -> (size_t) size of an array to be sorted.
-		@param compare -> (bool (*)(const Type&, const Type&)) (has default) pointer to a compare function.
+		@param first -> (int) index of first element of range.
+		@param last -> (int) index of last element of range.
+		@param depth -> (int) how many more times range can be partitioned before heap sort is used.
+		@param compare -> (Compare) compare function or function object.
 		@param log -> (Log *) (has default) pointer to an Log instance which is used for tracking sort moves.
 		@param info -> (int *) (has default) pointer to an integer array with 3 values (iteration number, switch number, compare number).
 		@param indexes -> (int *) (has default) pointer to an integer array which presents indexes of original list which is being sorted.
 	*/
-	template <typename T> 
-	static void quickSort(T** arr, int first, int last, bool (*compare)(const T&, const T&) = &defaultCompare, Log* log = nullptr, int* info = nullptr, int* indexes = nullptr)
+	template <typename T, typename Compare>
+	static void quickSort(T** arr, int first, int last, int depth, Compare compare, Log* log, int* info, int* indexes)
+	{
+		struct Range
+		{
+			int first, last, depth;
+		} stack[QUICK_STACK_SIZE];
+		int top = 0;
+
+		while (true)
+		{
+			if (last - first + 1 <= INSERTION_CUTOFF)
+				insertionSort<T>(arr, first, last, compare, log, info, indexes);
+			else if (depth-- == 0)
+				heapSort<T>(arr, first, last, compare, log, info, indexes);
+			else
+			{
+				if (info)
+					info[0]++;
+
+				int j = partition<T>(arr, first, last, compare, log, info, indexes);
+
+				// [first, j] <= pivot <= [j + 1, last], bigger part waits on stack
+				if (j - first < last - j)
+				{
+					Range range = { j + 1, last, depth };
+					stack[top++] = range;
+					last = j;
+				}
+				else
+				{
+					Range range = { first, j, depth };
+					stack[top++] = range;
+					first = j + 1;
+				}
+				continue;
+			}
+
+			if (top == 0)
+				break;
+			top--;
+			first = stack[top].first;
+			last = stack[top].last;
+			depth = stack[top].depth;
+		}
+	}
+
+	/*
+		Partial sort algorithm (heap select).
+
+		Same interface as quickSort, with count of smallest elements which are needed. After sorting first count
+		elements of array are count smallest elements (by compare function) in sorted order, and order of other
+		elements is unspecified. It takes O(size * log(count)) time, so it is much faster than full sort when
+		only first few elements of sorted order are needed.
+
+		First count elements are made into max heap (biggest of them at top). Each next element which is smaller
+		than top replaces it and is moved down, so heap always holds count smallest elements seen so far, and at
+		end heap is sorted in place (same as in heap sort).
+
+		If Log * is suplied as parameter, it is used same way as in quickSort (iteration number is incremented
+		for each element which enters heap and for each element taken from top while sorting heap).
+
+		@param arr -> (T **) array of T pointers.
+		@param size -> (size_t) size of an array.
+		@param count -> (size_t) number of smallest elements which should be sorted at start of array (if it
+						is bigger than size whole array is sorted).
+		@param compare -> (Compare) compare function or function object (bool operator()(const T&, const T&)).
+		@param log -> (Log *) (has default) pointer to an Log instance which is used for tracking sort moves.
+	*/
+	template <typename T, typename Compare>
+	static void partialSort(T** arr, size_t size, size_t count, Compare compare, Log* log = nullptr)
+	{
+		if (count > size)
+			count = size;
+
+		int info[] = {0, 0, 0}; // iterNum, switchNum, compareNum
+		int* indexes = nullptr;
+		if (log != nullptr)
+		{
+			indexes = new int[size];
+			for (unsigned int i = 0; i < size; i++)
+				indexes[i] = i;
+			log -> createEntry(indexes, 0, 0, 0);
+		}
+		int* tracked = log != nullptr ? info : nullptr;
+
+		int heap = (int) count;
+		for (int node = heap / 2 - 1; node >= 0; node--)
+			siftDown<T>(arr, 0, node, heap, compare, log, tracked, indexes);
+
+		for (int i = heap; i < (int) size && heap > 0; i++)
+		{
+			if (compareItems<T>(*arr[i], *arr[0], compare, tracked))
+			{
+				info[0]++;
+				switchItems<T>(arr, 0, i, log, tracked, indexes);
+				siftDown<T>(arr, 0, 0, heap, compare, log, tracked, indexes);
+			}
+		}
+
+		for (int end = heap - 1; end > 0; end--)
+		{
+			info[0]++;
+			switchItems<T>(arr, 0, end, log, tracked, indexes);
+			siftDown<T>(arr, 0, 0, end, compare, log, tracked, indexes);
+		}
+
+		delete[] indexes;
+	}
+
+	/*
+		Overload of partialSort for pointer to a compare function (has default), see partialSort above.
+	*/
+	template <typename T>
+	static void partialSort(T** arr, size_t size, size_t count, bool (*compare)(const T&, const T&) = &defaultCompare, Log* log = nullptr)
+	{
+		partialSort<T, bool (*)(const T&, const T&)>(arr, size, count, compare, log);
+	}
+
+	/*
+		Nth element algorithm (introselect).
+
+		Same interface as quickSort, with position nth. After it element at position nth is element which would be
+		there if array was sorted, elements before it are not bigger than it, and elements after it are not smaller
+		than it (but both parts are not sorted). It takes O(size) time on average.
+
+		Range is partitioned same way as in quickSort, but only part which holds nth is partitioned further, so
+		no stack is needed at all. Small range is finished with insertion sort, and if partitioning goes deeper
+		than 2 * log2(size) (bad pivots), range is finished with heap sort.
+
+		If Log * is suplied as parameter, it is used same way as in quickSort.
+
+		@param arr -> (T **) array of T pointers.
+		@param size -> (size_t) size of an array.
+		@param nth -> (size_t) position of element which should be found (nothing is done if it is not less than size).
+		@param compare -> (Compare) compare function or function object (bool operator()(const T&, const T&)).
+		@param log -> (Log *) (has default) pointer to an Log instance which is used for tracking sort moves.
+	*/
+	template <typename T, typename Compare>
+	static void nthElement(T** arr, size_t size, size_t nth, Compare compare, Log* log = nullptr)
+	{
+		int info[] = {0, 0, 0}; // iterNum, switchNum, compareNum
+		int* indexes = nullptr;
+		if (log != nullptr)
+		{
+			indexes = new int[size];
+			for (unsigned int i = 0; i < size; i++)
+				indexes[i] = i;
+			log -> createEntry(indexes, 0, 0, 0);
+		}
+		int* tracked = log != nullptr ? info : nullptr;
+
+		if (nth < size)
+		{
+			int depth = 0;
+			for (size_t n = size; n > 1; n >>= 1)
+				depth += 2;
+
+			int first = 0, last = (int) size - 1;
+			while (last - first + 1 > INSERTION_CUTOFF && depth-- > 0)
+			{
+				info[0]++;
+				int j = partition<T>(arr, first, last, compare, log, tracked, indexes);
+				if ((int) nth <= j)
+					last = j;
+				else
+					first = j + 1;
+			}
+
+			if (last - first + 1 <= INSERTION_CUTOFF)
+				insertionSort<T>(arr, first, last, compare, log, tracked, indexes);
+			else
+				heapSort<T>(arr, first, last, compare, log, tracked, indexes);
+		}
+
+		delete[] indexes;
+	}
+
+	/*
+		Overload of nthElement for pointer to a compare function (has default), see nthElement above.
+	*/
+	template <typename T>
+	static void nthElement(T** arr, size_t size, size_t nth, bool (*compare)(const T&, const T&) = &defaultCompare, Log* log = nullptr)
+	{
+		nthElement<T, bool (*)(const T&, const T&)>(arr, size, nth, compare, log);
+	}
+
+	/*
+		Radix sort algorithm (LSD, least significant byte first).
+
+		Unlike other sorts it doesn't sort array of pointers with compare function, it sorts array of unsigned
+		integer keys (Key is unsigned int or unsigned long long) in ascending order, and fills indexes with
+		positions of keys in sorted order (same format as FlightHandler uses for ordering). Sort is stable.
+
+		(key, index) pairs are distributed by one byte of key per pass, between two buffers (each pass reads
+		one and writes other). Counts of all bytes are made in one pass over keys before sorting, and passes
+		for bytes which are same in all keys are skipped (they wouldn't change order).
+
+		If Log * is suplied as parameter, first entry is original order, and new Entry is stored after each
+		pass (iteration number is number of pass, switch number counts rows which changed place, there are
+		no compares).
+
+		@param keys -> (const Key *) array of keys.
+		@param size -> (size_t) number of keys.
+		@param indexes -> (int *) array (with place for size elements) which will be filled with sorted order.
+		@param log -> (Log *) (has default) pointer to an Log instance which is used for tracking sort moves.
+	*/
+	template <typename Key>
+	static void radixSort(const Key* keys, size_t size, int* indexes, Log* log = nullptr)
+	{
+		struct Pair
+		{
+			Key key;
+			int index;
+		};
+		const int BYTES = sizeof(Key);
+
+		int* order = nullptr;
+		if (log != nullptr)
+		{
+			order = new int[size];
+			for (unsigned int i = 0; i < size; i++)
+				order[i] = i;
+			log -> createEntry(order, 0, 0, 0);
+		}
+
+		if (size == 0)
+		{
+			delete[] order;
+			return;
+		}
+
+		std::vector<Pair> first(size), second(size);
+		std::vector<size_t> counts(BYTES * 256, 0);
+		for (size_t i = 0; i < size; i++)
+		{
+			first[i].key = keys[i];
+			first[i].index = (int) i;
+			for (int b = 0; b < BYTES; b++)
+				counts[b * 256 + ((keys[i] >> (8 * b)) & 0xFF)]++;
+		}
+
+		Pair* from = &first[0];
+		Pair* to = &second[0];
+		int pass = 0, moved = 0;
+		for (int b = 0; b < BYTES; b++)
+		{
+			size_t* count = &counts[b * 256];
+			if (count[(from[0].key >> (8 * b)) & 0xFF] == size)
+				continue;
+
+			// counts become positions where each byte value starts
+			size_t offset = 0;
+			for (int value = 0; value < 256; value++)
+			{
+				size_t number = count[value];
+				count[value] = offset;
+				offset += number;
+			}
+
+			for (size_t i = 0; i < size; i++)
+				to[count[(from[i].key >> (8 * b)) & 0xFF]++] = from[i];
+			std::swap(from, to);
+
+			if (log != nullptr)
+			{
+				for (size_t i = 0; i < size; i++)
+				{
+					if (order[i] != from[i].index)
+						moved++;
+					order[i] = from[i].index;
+				}
+				log -> createEntry(order, ++pass, moved, 0);
+			}
+		}
+
+		for (size_t i = 0; i < size; i++)
+			indexes[i] = from[i].index;
+		delete[] order;
+	}
+
+	/*
+		String (null terminated) with its position in array which is being sorted, used by multikeySort.
+	*/
+	struct StringItem
+	{
+		const char* text;
+		int index;
+	};
+
+	/*
+		Multikey Sort Algorithm Support.
+
+		This is "private" recursive function which is called from multikey sort "public" interface, and by itself.
+
+		All strings in range have same first depth chars. Range is split in three parts by char at depth
+		(smaller, equal and bigger than char of pivot, which is median of first, middle and last string).
+		Smaller and bigger parts are sorted by recursive call, and equal part by next pass of loop with next
+		char (unless strings ended), so chars before depth are never compared again. If all strings have same
+		char, their whole common prefix is found in one pass instead. Ranges smaller than INSERTION_CUTOFF are
+		finished with insertion sort which compares strings from depth.
+
+		@param items -> (StringItem *) range of strings.
+		@param size -> (int) number of strings in range.
+		@param depth -> (size_t) number of first chars which are same in all strings of range.
+	*/
+	inline void multikeySort(StringItem* items, int size, size_t depth)
+	{
+		while (size > INSERTION_CUTOFF)
+		{
+			int first = (unsigned char) items[0].text[depth];
+			int middle = (unsigned char) items[size / 2].text[depth];
+			int last = (unsigned char) items[size - 1].text[depth];
+			int pivot = first < middle ? (middle < last ? middle : (first < last ? last : first))
+										: (first < last ? first : (middle < last ? last : middle));
+
+			// [0, less) < pivot, [less, i) == pivot, (greater, size) > pivot
+			int less = 0, i = 0, greater = size - 1;
+			while (i <= greater)
+			{
+				int c = (unsigned char) items[i].text[depth];
+				if (c < pivot)
+					std::swap(items[less++], items[i++]);
+				else if (c > pivot)
+					std::swap(items[i], items[greater--]);
+				else
+					i++;
+			}
+
+			if (pivot == 0)
+			{
+				multikeySort(items + greater + 1, size - greater - 1, depth);
+				return;
+			}
+
+			// duplicates would otherwise be partitioned again for each of their chars
+			if (less == 0 && greater == size - 1)
+			{
+				const char* text = items[0].text + depth;
+				size_t common = strlen(text);
+				for (int k = 1; k < size; k++)
+				{
+					const char* other = items[k].text + depth;
+					size_t j = 1;
+					while (j < common && text[j] == other[j])
+						j++;
+					common = j;
+				}
+				depth += common;
+				continue;
+			}
+
+			multikeySort(items, less, depth);
+			multikeySort(items + greater + 1, size - greater - 1, depth);
+
+			items += less;
+			size = greater - less + 1;
+			depth++;
+		}
+
+		for (int i = 1; i < size; i++)
+			for (int j = i; j > 0 && strcmp(items[j].text + depth, items[j - 1].text + depth) < 0; j--)
+				std::swap(items[j], items[j - 1]);
+	}
+
+	/*
+		Multikey sort algorithm (Bentley-Sedgewick multikey quick sort) for null terminated strings.
+
+		Like radixSort, it doesn't use compare function. It sorts array of strings in alphabetical order
+		(same as strcmp), and fills indexes with positions of strings in sorted order. Strings are
+		compared char by char, and common prefix of strings is compared only once (not on each compare
+		as in comparison sorts), which pays off when many strings begin same way ("San ...", "New ...").
+
+		@param strings -> (const char **) array of strings.
+		@param size -> (size_t) number of strings.
+		@param indexes -> (int *) array (with place for size elements) which will be filled with sorted order.
+	*/
+	inline void multikeySort(const char** strings, size_t size, int* indexes)
+	{
+		if (size == 0)
+			return;
+
+		std::vector<StringItem> items(size);
+		for (size_t i = 0; i < size; i++)
+		{
+			items[i].text = strings[i];
+			items[i].index = (int) i;
+		}
+
+		multikeySort(&items[0], (int) size, 0);
+
+		for (size_t i = 0; i < size; i++)
+			indexes[i] = items[i].index;
+	}
+
+	/*
+		Number of elements under which parallel sort doesn't split work any more (range is sorted or merged on one thread).
+	*/
+	const size_t PARALLEL_GRAIN = 1 << 14;
+
+	/*
+		Parallel Sort Algorithm Support.
+
+		Merges two sorted ranges into out. If ranges are big, middle element of bigger range is found in other
+		one (binary search), and both halves of merge (elements before it and after it) are merged in parallel.
+
+		@param first -> (T **) first sorted range.
+		@param firstSize -> (size_t) size of first range.
+		@param second -> (T **) second sorted range.
+		@param secondSize -> (size_t) size of second range.
+		@param out -> (T **) array with place for both ranges.
+		@param compare -> (bool (*)(const T&, const T&)) pointer to a compare function.
+		@param pool -> (TaskPool&) pool which runs tasks.
+		@param worker -> (unsigned) index of worker which calls function.
+	*/
+	template <typename T, typename Compare>
+	void parallelMerge(T** first, size_t firstSize, T** second, size_t secondSize, T** out, Compare compare, TaskPool& pool, unsigned worker)
+	{
+		if (firstSize + secondSize <= PARALLEL_GRAIN)
+		{
+			size_t i = 0, j = 0;
+			while (i < firstSize && j < secondSize)
+				*out++ = compare(*second[j], *first[i]) ? second[j++] : first[i++];
+			out = std::copy(first + i, first + firstSize, out);
+			std::copy(second + j, second + secondSize, out);
+			return;
+		}
+
+		if (firstSize < secondSize)
+		{
+			std::swap(first, second);
+			std::swap(firstSize, secondSize);
+		}
+
+		// second[0, low) < first[middle] <= second[low, secondSize)
+		size_t middle = firstSize / 2, low = 0, high = secondSize;
+		while (low < high)
+		{
+			size_t mid = low + (high - low) / 2;
+			if (compare(*second[mid], *first[middle]))
+				low = mid + 1;
+			else
+				high = mid;
+		}
+
+		TaskPool::Join join;
+		pool.spawn(worker, join, [=, &pool](unsigned w)
+		{
+			parallelMerge<T>(first, middle, second, low, out, compare, pool, w);
+		});
+		parallelMerge<T>(first + middle, firstSize - middle, second + low, secondSize - low, out + middle + low, compare, pool, worker);
+		pool.wait(worker, join);
+	}
+
+	/*
+		Parallel Sort Algorithm Support.
+
+		Sorts range, and leaves result in arr (or in buffer if intoBuffer is true). Halves of range are sorted
+		in parallel (into other array), and then merged back (parallelMerge). Ranges smaller than PARALLEL_GRAIN
+		are sorted with quickSort.
+
+		@param arr -> (T **) range which is sorted.
+		@param buffer -> (T **) range of same size used for merging.
+		@param size -> (size_t) size of range.
+		@param intoBuffer -> (bool) true if result should be in buffer instead of arr.
+		@param compare -> (bool (*)(const T&, const T&)) pointer to a compare function.
+		@param pool -> (TaskPool&) pool which runs tasks.
+		@param worker -> (unsigned) index of worker which calls function.
+	*/
+	template <typename T, typename Compare>
+	void parallelMergeSort(T** arr, T** buffer, size_t size, bool intoBuffer, Compare compare, TaskPool& pool, unsigned worker)
+	{
+		if (size <= PARALLEL_GRAIN)
+		{
+			quickSort<T>(arr, size, compare);
+			if (intoBuffer)
+				std::copy(arr, arr + size, buffer);
+			return;
+		}
+
+		size_t half = size / 2;
+		TaskPool::Join join;
+		pool.spawn(worker, join, [=, &pool](unsigned w)
+		{
+			parallelMergeSort<T>(arr, buffer, half, !intoBuffer, compare, pool, w);
+		});
+		parallelMergeSort<T>(arr + half, buffer + half, size - half, !intoBuffer, compare, pool, worker);
+		pool.wait(worker, join);
+
+		if (intoBuffer)
+			parallelMerge<T>(arr, half, arr + half, size - half, buffer, compare, pool, worker);
+		else
+			parallelMerge<T>(buffer, half, buffer + half, size - half, arr, compare, pool, worker);
+	}
+
+	/*
+		Parallel sort algorithm (fork-join merge sort).
+
+		Same interface as quickSort. Array is split in halves until parts are smaller than PARALLEL_GRAIN,
+		parts are sorted with quickSort and merged back, and both sorting and merging of parts are tasks of
+		TaskPool (work stealing), so all cores are used. It needs extra array of size pointers.
+
+		Switches of parallel sort don't have one order, so if Log * is suplied (or array is smaller than
+		PARALLEL_GRAIN), array is sorted with quickSort instead.
+
+		@param arr -> (T **) array of T pointers.
+		@param size -> (size_t) size of an array to be sorted.
+		@param compare -> (Compare) compare function or function object (bool operator()(const T&, const T&)).
+		@param log -> (Log *) (has default) pointer to an Log instance which is used for tracking sort moves.
+		@param threads -> (unsigned) (has default) number of threads, 0 means number of hardware threads.
+	*/
+	template <typename T, typename Compare>
+	static void parallelSort(T** arr, size_t size, Compare compare, Log* log = nullptr, unsigned threads = 0)
 	{
-		if (first >= last)
+		if (log != nullptr || size <= PARALLEL_GRAIN || threads == 1)
+		{
+			quickSort<T>(arr, size, compare, log);
 			return;
+		}
+
+		std::vector<T*> buffer(size);
+		TaskPool pool(threads);
+		parallelMergeSort<T>(arr, &buffer[0], size, false, compare, pool, 0);
+	}
+
+	/*
+		Overload of parallelSort for pointer to a compare function (has default), see parallelSort above.
+	*/
+	template <typename T>
+	static void parallelSort(T** arr, size_t size, bool (*compare)(const T&, const T&) = &defaultCompare, Log* log = nullptr, unsigned threads = 0)
+	{
+		parallelSort<T, bool (*)(const T&, const T&)>(arr, size, compare, log, threads);
+	}
+
+	/*
+		Class TimSort
+
+		Tim Sort Algorithm Support, holds state of one timSort call (so helper functions don't need long
+		parameter lists): sorted array, index list and Log (if sort is tracked), buffer for merging and
+		stack of runs which are not merged yet.
+
+		@author Acko.
+	*/
+	template <typename T, typename Compare>
+	class TimSort
+	{
+	private:
+		/* Runs shorter than this are extended (binary insertion sort) before they are merged */
+		static const size_t MIN_MERGE = 32;
+
+		/* Number of elements in a row taken from same run after which merge starts galloping */
+		static const size_t MIN_GALLOP = 7;
+
+		T** arr;
+		Compare compare;
+		Log* log;
+		int* info;
+		int* indexes;
+
+		/* Copy of left run while it is merged (and its indexes) */
+		std::vector<T*> buffer;
+		std::vector<int> bufferIndexes;
+
+		/* Stack of runs, begining and length of each one */
+		std::vector<size_t> runBase, runLength;
 
-		info[0]++;
-		int pivot = last;
-		int p = -1;
+		bool less(const T* t1, const T* t2)
+		{
+			return compareItems<T>(*t1, *t2, compare, info);
+		}
 
-		for (auto i = first; i <= last; i++)
+		/*
+			Moves count elements from position from to position to (ranges may overlap, copying goes
+			in right direction), together with their indexes if sort is tracked.
+		*/
+		void move(size_t from, size_t to, size_t count)
 		{
+			if (to < from)
+			{
+				std::copy(arr + from, arr + from + count, arr + to);
+				if (indexes)
+					std::copy(indexes + from, indexes + from + count, indexes + to);
+			}
+			else
+			{
+				std::copy_backward(arr + from, arr + from + count, arr + to + count);
+				if (indexes)
+					std::copy_backward(indexes + from, indexes + from + count, indexes + to + count);
+			}
 			if (info)
-				info[2]++;
-			if (compare(**(arr + i), **(arr + pivot)))
+				info[1] += (int) count;
+		}
+
+		/*
+			Stores new Entry into Log (if sort is tracked), after each run and each merge.
+		*/
+		void track()
+		{
+			if (info)
+				log -> createEntry(indexes, ++info[0], info[1], info[2]);
+		}
+
+		/*
+			Returns number of elements of sorted range which are not bigger than key (first position
+			where key can be put after equal elements). Range is checked from its begining at positions
+			1, 3, 7, 15..., and then binary searched between last two positions, so it takes only
+			log(result) compares.
+		*/
+		size_t gallopRight(const T* key, T** range, size_t size)
+		{
+			size_t low = 0, step = 1;
+			while (low + step <= size && !less(key, range[low + step - 1]))
+			{
+				low += step;
+				step *= 2;
+			}
+
+			size_t high = low + step <= size ? low + step - 1 : size;
+			while (low < high)
+			{
+				size_t middle = low + (high - low) / 2;
+				if (less(key, range[middle]))
+					high = middle;
+				else
+					low = middle + 1;
+			}
+			return low;
+		}
+
+		/*
+			Returns number of elements of sorted range which are smaller than key (first position where
+			key can be put before equal elements). Searched same way as in gallopRight.
+		*/
+		size_t gallopLeft(const T* key, T** range, size_t size)
+		{
+			size_t low = 0, step = 1;
+			while (low + step <= size && less(range[low + step - 1], key))
+			{
+				low += step;
+				step *= 2;
+			}
+
+			size_t high = low + step <= size ? low + step - 1 : size;
+			while (low < high)
+			{
+				size_t middle = low + (high - low) / 2;
+				if (less(range[middle], key))
+					low = middle + 1;
+				else
+					high = middle;
+			}
+			return low;
+		}
+
+		/*
+			Finds run which begins at position first and returns its length. Run is longest sorted range
+			(not descending), or strictly descending range which is then reversed (strictly, so equal elements
+			are never reversed and sort stays stable).
+		*/
+		size_t findRun(size_t first, size_t size)
+		{
+			size_t last = first + 1;
+			if (last == size)
+				return 1;
+
+			if (less(arr[last], arr[first]))
+			{
+				while (last + 1 < size && less(arr[last + 1], arr[last]))
+					last++;
+				std::reverse(arr + first, arr + last + 1);
+				if (indexes)
+					std::reverse(indexes + first, indexes + last + 1);
+				if (info)
+					info[1] += (int) (last - first + 1);
+			}
+			else
+				while (last + 1 < size && !less(arr[last + 1], arr[last]))
+					last++;
+
+			return last - first + 1;
+		}
+
+		/*
+			Binary insertion sort of range [first, end), first sorted elements of range are already sorted.
+			Each element is put after all equal elements, so sort stays stable.
+		*/
+		void insertionSort(size_t first, size_t sorted, size_t end)
+		{
+			for (size_t i = first + sorted; i < end; i++)
+			{
+				size_t place = first + gallopRight(arr[i], arr + first, i - first);
+				if (place == i)
+					continue;
+
+				T* item = arr[i];
+				int index = indexes ? indexes[i] : 0;
+				move(place, place + 1, i - place);
+				arr[place] = item;
+				if (indexes)
+					indexes[place] = index;
+			}
+		}
+
+		/*
+			Merges run at position n of stack with next one.
+
+			Elements of left run which are not bigger than first element of right run, and elements of right run
+			which are not smaller than last element of left run, are already in place, so they are skipped
+			(galloping). Rest of left run is copied into buffer and merged with right run from begining of left
+			run. When one run wins MIN_GALLOP times in a row, merge finds how many elements in a row it wins by
+			galloping and moves them all at once (this is what makes merging of nearly sorted runs fast).
+		*/
+		void mergeAt(size_t n)
+		{
+			size_t base = runBase[n], leftLength = runLength[n];
+			size_t right = runBase[n + 1], rightLength = runLength[n + 1];
+
+			runLength[n] += rightLength;
+			runBase.erase(runBase.begin() + n + 1);
+			runLength.erase(runLength.begin() + n + 1);
+
+			size_t skipped = gallopRight(arr[right], arr + base, leftLength);
+			base += skipped;
+			leftLength -= skipped;
+			if (leftLength == 0)
+				return;
+			rightLength = gallopLeft(arr[right - 1], arr + right, rightLength);
+			if (rightLength == 0)
+				return;
+
+			buffer.assign(arr + base, arr + base + leftLength);
+			if (indexes)
+				bufferIndexes.assign(indexes + base, indexes + base + leftLength);
+
+			size_t i = 0, j = right, end = right + rightLength, out = base;
+			while (i < leftLength && j < end)
 			{
-				if (arr + i != arr + first + ++p)
+				size_t leftWins = 0, rightWins = 0;
+				while (i < leftLength && j < end && leftWins < MIN_GALLOP && rightWins < MIN_GALLOP)
 				{
-					auto temp = *(arr + i);
-					*(arr + i) = *(arr + first + p);
-					*(arr + first + p) = temp;
-					if (info)
+					if (less(arr[j], buffer[i]))
+					{
+						arr[out] = arr[j];
+						if (indexes)
+							indexes[out] = indexes[j];
+						j++;
+						rightWins++;
+						leftWins = 0;
+					}
+					else
 					{
-						auto temp = *(indexes + i);
-						*(indexes + i) = *(indexes + first + p);
-						*(indexes + first + p) = temp;
-						log -> createEntry(indexes, info[0], ++info[1], info[2]);
+						arr[out] = buffer[i];
+						if (indexes)
+							indexes[out] = bufferIndexes[i];
+						i++;
+						leftWins++;
+						rightWins = 0;
 					}
+					out++;
+					if (info)
+						info[1]++;
+				}
+				if (i == leftLength || j == end)
+					break;
+
+				if (leftWins == MIN_GALLOP)
+				{
+					size_t count = gallopRight(arr[j], &buffer[i], leftLength - i);
+					std::copy(buffer.begin() + i, buffer.begin() + i + count, arr + out);
+					if (indexes)
+						std::copy(bufferIndexes.begin() + i, bufferIndexes.begin() + i + count, indexes + out);
+					if (info)
+						info[1] += (int) count;
+					i += count;
+					out += count;
+				}
+				else
+				{
+					size_t count = gallopLeft(buffer[i], arr + j, end - j);
+					move(j, out, count);
+					j += count;
+					out += count;
 				}
 			}
+
+			// rest of right run is already in place
+			std::copy(buffer.begin() + i, buffer.begin() + leftLength, arr + out);
+			if (indexes)
+				std::copy(bufferIndexes.begin() + i, bufferIndexes.begin() + leftLength, indexes + out);
+			if (info)
+				info[1] += (int) (leftLength - i);
 		}
 
-		if (arr + pivot != arr + first + ++p)
+		/*
+			Merges runs on top of stack until their lengths shrink fast enough going down the stack (each run
+			longer than next two together), so merged runs are always of similar length and stack stays short.
+		*/
+		void mergeCollapse()
 		{
-			auto temp = *(arr + pivot);
-			*(arr + pivot) = *(arr + first + p);
-			*(arr + first + p) = temp;
-			if (info)
+			while (runLength.size() > 1)
+			{
+				size_t n = runLength.size() - 2;
+				if ((n > 0 && runLength[n - 1] <= runLength[n] + runLength[n + 1]) ||
+					(n > 1 && runLength[n - 2] <= runLength[n - 1] + runLength[n]))
+				{
+					if (runLength[n - 1] < runLength[n + 1])
+						n--;
+				}
+				else if (runLength[n] > runLength[n + 1])
+					break;
+				mergeAt(n);
+				track();
+			}
+		}
+
+	public:
+		TimSort(T** arr, Compare compare, Log* log, int* info, int* indexes)
+			: arr(arr), compare(compare), log(log), info(info), indexes(indexes)
+		{
+		}
+
+		/*
+			Sorts array. It is split in runs (short ones are extended to minimal length), each run is pushed on
+			stack and merged with previous ones while stack rule is broken, and in the end all runs are merged.
+		*/
+		void sort(size_t size)
+		{
+			// minimal run length is between MIN_MERGE / 2 and MIN_MERGE, chosen so that size / minRun is
+			// power of 2 or little less than it (then merges are balanced)
+			size_t minRun = size, extra = 0;
+			while (minRun >= MIN_MERGE)
+			{
+				extra |= minRun & 1;
+				minRun >>= 1;
+			}
+			minRun += extra;
+
+			for (size_t first = 0; first < size; )
+			{
+				size_t length = findRun(first, size);
+				if (length < minRun)
+				{
+					size_t extended = size - first < minRun ? size - first : minRun;
+					insertionSort(first, length, first + extended);
+					length = extended;
+				}
+
+				runBase.push_back(first);
+				runLength.push_back(length);
+				track();
+				mergeCollapse();
+				first += length;
+			}
+
+			while (runLength.size() > 1)
 			{
-				auto temp = *(indexes + pivot);
-				*(indexes + pivot) = *(indexes + first + p);
-				*(indexes + first + p) = temp;
-				log -> createEntry(indexes, info[0], ++info[1], info[2]);
+				size_t n = runLength.size() - 2;
+				if (n > 0 && runLength[n - 1] < runLength[n + 1])
+					n--;
+				mergeAt(n);
+				track();
 			}
 		}
+	};
+
+	/*
+		Tim sort algorithm (stable, adaptive merge sort).
+
+		Same interface as quickSort, but sort is stable (elements which are equal by compare function stay in
+		same order as before sorting, so sorting by one criteria after other keeps order of first criteria
+		inside each group of second one). It finds already sorted (or reverse sorted) parts of array and merges
+		them, so nearly sorted arrays are sorted in almost linear time. See class TimSort.
+
+		If Log * is suplied as parameter, index list is tracked as in other sorts, and new Entry is stored after
+		each run is found and after each merge (iteration number counts those steps, switch number counts moved
+		elements).
+
+		@param arr -> (T **) array of T pointers.
+		@param size -> (size_t) size of an array to be sorted.
+		@param compare -> (Compare) compare function or function object (bool operator()(const T&, const T&)).
+		@param log -> (Log *) (has default) pointer to an Log instance which is used for tracking sort moves.
+	*/
+	template <typename T, typename Compare>
+	static void timSort(T** arr, size_t size, Compare compare, Log* log = nullptr)
+	{
+		if (log != nullptr)
+		{
+			int* indexes = new int[size];
+			for (unsigned int i = 0; i < size; i++)
+				indexes[i] = i;
+			log -> createEntry(indexes, 0, 0, 0);
+
+			int info[] = {0, 0, 0}; // iterNum, switchNum, compareNum
+			TimSort<T, Compare>(arr, compare, log, info, indexes).sort(size);
+			delete[] indexes;
+		}
+		else
+			TimSort<T, Compare>(arr, compare, nullptr, nullptr, nullptr).sort(size);
+	}
 
-		quickSort(arr, first, first + p - 1, compare, log, info, indexes);
-		quickSort(arr, first + p + 1, last, compare, log, info, indexes);
+	/*
+		Overload of timSort for pointer to a compare function (has default), see timSort above.
+	*/
+	template <typename T>
+	static void timSort(T** arr, size_t size, bool (*compare)(const T&, const T&) = &defaultCompare, Log* log = nullptr)
+	{
+		timSort<T, bool (*)(const T&, const T&)>(arr, size, compare, log);
 	}
 };
 
@@ -2,186 +2,227 @@
 #define _STREAM_READER_INCLUDED_
 
 #include <stdexcept>
-#include <vector>
-#include <list>
+#include <tuple>
 #include <iostream>
 
 /*
 	Namespace specially designed for parsing input from streams.
 
-	It contains two classes, one for defining pattern which should be read from stream, and
-	another one to be some kind of data container for data read from stream.
+	It contains types for describing pattern which should be read from stream (one type per pattern
+	character), and Pattern template which joins them and reads whole pattern from stream.
 
 	Idea:
-		StreamReader::InputType parses string passed to it, and stores list of ints
-		(defined by its enumeration) as a types which should be read from stream. And that is
-		passed to readStream function, which then uses few mini funcitions for reading Stream
-		in appropriate order which InputType::info (list) declares, creates objects of those
-		types on heap, and casts their pointers to (void *) which stores inside its vector.
-		User gets back pointer to a StreamReader::UserObject and can access its data vector,
-		and then by indexes should parse its (void *) to appropriate type pointers.
-		UserObject will delete all object it created, but you must delete pointer returned to you
-		by function readStream()
-
-		@note Not exactly typesafe.
+		Pattern is described at compile time, as list of field types passed to StreamReader::Pattern.
+		Pattern::read() reads stream field by field in that order (each field type knows how to read
+		and validate itself), and returns std::tuple with one value for each field. Result is returned
+		by value (on stack), nothing is allocated on heap, and types of values are checked by compiler.
 
 	Pattern:
-		Pattern is simple string, but can contain only next characters:
+		Field types match characters of old string patterns:
 
-		c - 'char'
-		s - 'const char *'
-		i - 'int'
-		d - 'digit'
-		f - 'float'
-		D - 'double'
+		c - StreamReader::Char		-> char (english alphabet character, '.', ' ' or ':')
+		s - StreamReader::String	-> StreamReader::Text (chars until delimiter)
+		i - StreamReader::Int		-> int
+		d - StreamReader::Digit		-> char (digit)
+		f - StreamReader::Float		-> float
+		D - StreamReader::Double	-> double
 
 	Simple Example:
 		try
 		{
-			StreamReader::InputType in("ccisD", 100, ';');
-			StreamReader::UserObject* uo = StreamReader::readStream(stdin, in);
-
-			char c = * (char *) uo -> data[0];
-			char d = * (char *) uo -> data[1];
-			int a = * (int *) uo -> data[2];
-			std::string = * (std::string *) uo -> data[3];
-			double dd = * (double *) uo -> data[4];
-
-			delete uo;
-		}
-		catch (StreamReader::InvalidPattern& e)
-		{
-			std::cerr << e.what() << std::endl;
+			typedef StreamReader::Pattern<StreamReader::Char, StreamReader::Char, StreamReader::Int,
+											StreamReader::String<100, ';'>, StreamReader::Double> MyPattern;
+			MyPattern::Result r = MyPattern::read(std::cin);
+
+			char c = std::get<0>(r);
+			char d = std::get<1>(r);
+			int a = std::get<2>(r);
+			std::string s = std::get<3>(r).text;
+			double dd = std::get<4>(r);
 		}
 		catch (std::exception&)
 		{
 			std::cerr << "Input doesn't match pattern passed!\n";
 		}
 
-	@TODO:
-		fix memory leak with strings (deallocating).
-
 	@author Acko.
 */
 namespace StreamReader
 {
 	/*
-		Exception derived class
+		Function which determines if char is valid for 'c' pattern type (english alphabet character, '.', ' ' or ':').
+	*/
+	bool isChar(char);
 
-		It will be thrown if pattern isn't valid.
+	/*
+		Function which determines if char is valid for 'd' pattern type (digit).
 	*/
-	struct InvalidPattern;
+	bool isNum(char);
 
 	/*
-		Class presenting interface between user (string passed) and UserObject.
+		Function which clears given stream until it finds first occurance of character sent to it.
+		Delimiter char is also cleared from stream.
+	*/
+	void clearStream(std::istream&, char = '\n');
 
-		It contains enumeration which is stored in list of information after parsing string
-		passed to constructor, and it is a bypass object which describes how stream should be
-		read.
+	//-----------------------------------------------------------------------
+	// Field types, each one has Type (type of value which is read) and
+	// static read function which reads value from stream, and throws
+	// std::exception if stream doesn't match field.
+	//-----------------------------------------------------------------------
 
-		@author Acko.
-	*/
-	class InputType
+	/* 'c' - one english alphabet character (or '.', ' ', ':') */
+	struct Char
 	{
-	public:
-		/*
-			Integer that describes upper bond for character number when reading string type 
-		*/
-		int MAX_CHAR;
-
-		/*
-			Character which describes delimiter char when reading string type.
-
-			Delimiter is not loaded into result, but it is removed from stream.
-		*/
-		char DELIMITER;
-
-		/*
-			Constructor, 
-
-			It takes pattern string which is parsed into list of enumeration,
-			and two optional parameters (MAX_CHAR and DELIMITER).
-		*/
-		InputType(const char *, int = 50, char = '\n'); 
-
-		/*
-			Enumeration which is used to describe which type should be read from stream.
-		*/
-		enum { CHAR, INT, DIGIT, FLOAT, DOUBLE, STRING };
-
-		/*
-			List of Enumeration, descriptor list - pattern parsed.
-		*/
-		std::list<int> info;
+		typedef char Type;
+		static void read(std::istream&, char&);
 	};
 
-	/*
-		Class presenting data container.
+	/* 'd' - one digit character */
+	struct Digit
+	{
+		typedef char Type;
+		static void read(std::istream&, char&);
+	};
 
-		When stream is read, data is recorded on heap, and those pointers are casted to (void *)
-		and stored inside this objects data list.
+	/* 'i' - integer */
+	struct Int
+	{
+		typedef int Type;
+		static void read(std::istream&, int&);
+	};
+
+	/* 'f' - float */
+	struct Float
+	{
+		typedef float Type;
+		static void read(std::istream&, float&);
+	};
 
-		@note All data which is pushed to this object will be destroyed when object is destoryed.
+	/* 'D' - double */
+	struct Double
+	{
+		typedef double Type;
+		static void read(std::istream&, double&);
+	};
+
+	/*
+		Fixed size char buffer which holds text read by String field (null terminated).
 	*/
-	class UserObject
+	template <int MAX_CHAR>
+	struct Text
 	{
-	private:
-		/*
-			Deletes all objects from heap (going thorugh vector) and clears out vector.
-		*/
-		void clear();
-	public:
-		/*
-			Constructor, Empty.
-		*/
-		UserObject();
-
-		/*
-			Destructor deletes all objects stored in vector data.
-		*/
-		~UserObject();
-
-		/*
-			Function that stores void * passed to it inside data vector.
-		*/
-		void addValue(void *);
-
-		/*
-			Vector which holds all void pointers to data.
-		*/
-		std::vector<void *> data;
-
-		/*
-			Function which delete's pointer sent to it if it is not nullptr, and calls clear() method.
-		*/
-		void fail(void * = nullptr);
+		char text[MAX_CHAR];
+		int length;
 	};
 
 	/*
-		Main function from this namespace.
+		's' - chars until delimiter, at most MAX_CHAR - 1 of them.
+		Delimiter is not loaded into result, but it is removed from stream.
+	*/
+	template <int MAX_CHAR = 50, char DELIMITER = '\n'>
+	struct String
+	{
+		typedef Text<MAX_CHAR> Type;
 
-		It takes InputType object reference from which it reads info list, and by that, it reads
-		istream sent as first parameter, alocates memory dynamically an casts new pointer to void,
-		which then store inside UserObject that it also created dynamically on beggining.
+		static void read(std::istream& _in, Text<MAX_CHAR>& _t)
+		{
+			_t.length = 0;
+			char c;
+			while (_t.length < MAX_CHAR - 1)
+			{
+				_in.get(c);
+				if (_in.fail())
+					throw std::exception("File corrupted");
+				if (c == DELIMITER)
+					break;
+				_t.text[_t.length++] = c;
+			}
+			_t.text[_t.length] = '\0';
+		}
+	};
 
-		If Stream reading fail in some point, it calls self method fail, which destroys, UserObject
-		created, and throws an exception.
+	//-----------------------------------------------------------------------
+	// END OF field types
+	//-----------------------------------------------------------------------
 
-		@TODO: fix memory leak with strings...
+	/*
+		Recursive helper which reads fields one by one (I-th field into I-th tuple element).
+		Shouldn't be used directly, Pattern::read() uses it.
 	*/
-	UserObject* readStream(std::istream&, const InputType&);
+	template <int I, typename... Fields>
+	struct FieldReader
+	{
+		template <typename Result>
+		static void read(std::istream&, Result&)
+		{
+		}
+	};
+
+	template <int I, typename Field, typename... Rest>
+	struct FieldReader<I, Field, Rest...>
+	{
+		template <typename Result>
+		static void read(std::istream& _in, Result& _r)
+		{
+			Field::read(_in, std::get<I>(_r));
+			FieldReader<I + 1, Rest...>::read(_in, _r);
+		}
+	};
 
 	/*
-		Function which clears given stream until it finds first occurance of character sent to it.
-		Delimiter char is also cleared from stream.
+		Class presenting pattern which should be read from stream.
+
+		Pattern is list of field types, Result is tuple of their value types, and read() reads
+		fields from stream in given order. If stream doesn't match pattern std::exception is thrown.
 	*/
-	void clearStream(std::istream&, char = '\n');
+	template <typename... Fields>
+	struct Pattern
+	{
+		typedef std::tuple<typename Fields::Type...> Result;
+
+		static Result read(std::istream& _in)
+		{
+			Result result;
+			FieldReader<0, Fields...>::read(_in, result);
+			return result;
+		}
+	};
 
 	/*
-		Function which deallocates memory for UserObject (and all that is allocated untill that point)
-		and throws exception.
+		Recursive helper which copies char elements of tuple into char buffer.
+		Shouldn't be used directly, copyChars() uses it.
 	*/
-	void fail(UserObject* = nullptr, void* = nullptr);
+	template <int I, int SIZE>
+	struct CharCopier
+	{
+		template <typename Result>
+		static void copy(const Result& _r, char* _buffer)
+		{
+			_buffer[I] = std::get<I>(_r);
+			CharCopier<I + 1, SIZE>::copy(_r, _buffer);
+		}
+	};
+
+	template <int SIZE>
+	struct CharCopier<SIZE, SIZE>
+	{
+		template <typename Result>
+		static void copy(const Result&, char* _buffer)
+		{
+			_buffer[SIZE] = '\0';
+		}
+	};
+
+	/*
+		Function which copies result of pattern made only of Char and Digit fields into char buffer
+		(buffer must have place for one char per field plus null terminator).
+	*/
+	template <typename Result>
+	void copyChars(const Result& _r, char* _buffer)
+	{
+		CharCopier<0, std::tuple_size<Result>::value>::copy(_r, _buffer);
+	}
 };
 
-#endif
\ No newline at end of file
+#endif
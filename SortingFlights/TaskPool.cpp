@@ -0,0 +1,150 @@
+#include "TaskPool.h"
+
+/*
+	Constructor, creates deque for each worker and starts all workers except first one (calling thread).
+
+	@param threads -> (unsigned) (has default) number of workers, 0 means number of hardware threads.
+*/
+TaskPool::TaskPool(unsigned threads)
+	: queued(0), stopping(false)
+{
+	if (threads == 0)
+		threads = std::thread::hardware_concurrency();
+	if (threads == 0)
+		threads = 1;
+
+	for (unsigned i = 0; i < threads; i++)
+		workers.push_back(new Worker());
+
+	for (unsigned i = 1; i < threads; i++)
+		this -> threads.push_back(std::thread(&TaskPool::loop, this, i));
+}
+
+/*
+	Destructor, wakes all sleeping workers, waits for them to finish, and deletes deques.
+*/
+TaskPool::~TaskPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepLock);
+		stopping = true;
+	}
+	wake.notify_all();
+
+	for (size_t i = 0; i < threads.size(); i++)
+		threads[i].join();
+
+	for (size_t i = 0; i < workers.size(); i++)
+		delete workers[i];
+}
+
+/*
+	Function which returns number of workers (calling thread included).
+
+	@returns (unsigned) number of workers.
+*/
+unsigned TaskPool::size() const
+{
+	return (unsigned) workers.size();
+}
+
+/*
+	Function which adds task at back of deque of worker, counts it in join, and wakes one sleeping worker.
+
+	@param worker -> (unsigned) index of worker which spawns task.
+	@param join -> (Join&) join which counts task.
+	@param task -> (const Task&) task.
+*/
+void TaskPool::spawn(unsigned worker, Join& join, const Task& task)
+{
+	join.pending++;
+
+	Entry entry = { task, &join };
+	{
+		std::lock_guard<std::mutex> lock(workers[worker] -> lock);
+		workers[worker] -> tasks.push_back(entry);
+	}
+	queued++;
+
+	// worker which checked queued just before it changed is surely waiting once sleepLock is free
+	{
+		std::lock_guard<std::mutex> lock(sleepLock);
+	}
+	wake.notify_one();
+}
+
+/*
+	Function which runs tasks until all tasks counted in join are finished. Worker doesn't wait idle,
+	it runs any task it can get (own or stolen), so all workers can wait at same time without deadlock.
+
+	@param worker -> (unsigned) index of worker which waits.
+	@param join -> (Join&) join which is waited.
+*/
+void TaskPool::wait(unsigned worker, Join& join)
+{
+	while (join.pending > 0)
+		if (!runOne(worker))
+			std::this_thread::yield();
+}
+
+/*
+	Function which takes task from back of own deque, or if it is empty from front of other deque
+	(starting from next worker), and runs it.
+
+	@param worker -> (unsigned) index of worker.
+
+	@returns (bool) true if task was run, false if all deques were empty.
+*/
+bool TaskPool::runOne(unsigned worker)
+{
+	Entry entry;
+	bool found = false;
+
+	for (size_t i = 0; i < workers.size() && !found; i++)
+	{
+		Worker* victim = workers[(worker + i) % workers.size()];
+		std::lock_guard<std::mutex> lock(victim -> lock);
+		if (victim -> tasks.empty())
+			continue;
+
+		if (i == 0)
+		{
+			entry = victim -> tasks.back();
+			victim -> tasks.pop_back();
+		}
+		else
+		{
+			entry = victim -> tasks.front();
+			victim -> tasks.pop_front();
+		}
+		found = true;
+	}
+
+	if (!found)
+		return false;
+
+	queued--;
+	entry.task(worker);
+	entry.join -> pending--;
+	return true;
+}
+
+/*
+	Function which is run by each started worker, it runs tasks while there are any, and sleeps otherwise.
+
+	@param worker -> (unsigned) index of worker.
+*/
+void TaskPool::loop(unsigned worker)
+{
+	while (true)
+	{
+		if (runOne(worker))
+			continue;
+
+		std::unique_lock<std::mutex> lock(sleepLock);
+		while (!stopping && queued == 0)
+			wake.wait(lock);
+		if (stopping)
+			return;
+	}
+}
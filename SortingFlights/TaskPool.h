@@ -0,0 +1,115 @@
+#ifndef _TASK_POOL_INCLUDED_
+#define _TASK_POOL_INCLUDED_
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+/*
+	Class TaskPool
+
+	Small work stealing thread pool for fork-join algorithms (Sorter::parallelSort).
+
+	Each worker has its own deque of tasks. Worker puts tasks which it spawns at back of its own deque,
+	and takes them from back too (newest first, so it continues with data which is still in cache),
+	and when its deque is empty it steals oldest task from front of other deque (oldest tasks are
+	biggest parts of work, so stealing is rare). Idle workers sleep until new task is spawned.
+
+	Thread which creates pool is worker 0 (it runs tasks only while it waits in wait()), and other
+	threads - 1 workers are started by constructor. Each task gets index of worker which runs it, and it
+	must pass that index to spawn and wait (this way no thread local storage is needed).
+	Tasks must not throw.
+
+	@author Acko.
+*/
+class TaskPool
+{
+public:
+	/*
+		Task, gets index of worker which runs it.
+	*/
+	typedef std::function<void(unsigned)> Task;
+
+	/*
+		Counter of spawned tasks which are not finished yet, wait() returns when it drops to 0.
+	*/
+	struct Join
+	{
+		std::atomic<int> pending;
+
+		Join()
+			: pending(0)
+		{
+		}
+	};
+
+private:
+	/* Task with counter of its join */
+	struct Entry
+	{
+		Task task;
+		Join* join;
+	};
+
+	/* Deque of one worker, and lock which guards it */
+	struct Worker
+	{
+		std::deque<Entry> tasks;
+		std::mutex lock;
+	};
+
+	std::vector<Worker*> workers;
+	std::vector<std::thread> threads;
+
+	/* Number of tasks in all deques, and sleeping of idle workers */
+	std::atomic<int> queued;
+	bool stopping;
+	std::mutex sleepLock;
+	std::condition_variable wake;
+
+	/* Copying is not allowed */
+	TaskPool(const TaskPool&);
+	TaskPool& operator=(const TaskPool&);
+
+	/*
+		Function which takes one task (own one or stolen) and runs it, returns false if there was none.
+	*/
+	bool runOne(unsigned);
+
+	/*
+		Function which is run by each started worker until pool is destroyed.
+	*/
+	void loop(unsigned);
+
+public:
+	/*
+		Constructor, starts threads - 1 workers (0 means number of hardware threads).
+	*/
+	TaskPool(unsigned = 0);
+
+	/*
+		Destructor, stops and joins all started workers (all joins must be waited before).
+	*/
+	~TaskPool();
+
+	/*
+		Function which returns number of workers (calling thread included).
+	*/
+	unsigned size() const;
+
+	/*
+		Function which adds task to deque of worker (first parameter), and counts it in join.
+	*/
+	void spawn(unsigned, Join&, const Task&);
+
+	/*
+		Function which runs tasks on worker (first parameter) until all tasks of join are finished.
+	*/
+	void wait(unsigned, Join&);
+};
+
+#endif